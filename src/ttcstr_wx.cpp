@@ -19,63 +19,20 @@
 #include <ttlib_wx.h>
 
 #include <ttcstr_wx.h>
+#include <ttpath_wx.h>  // Lexical path operations that don't access the file system
+#include <ttutf8_wx.h>  // UTF-8 code point decoding, iteration, counting and indexing
 
 using namespace ttlib;
 using namespace tt;
 
 bool cstr::is_sameas(std::string_view str, CASE checkcase) const
 {
-    if (size() != str.size())
-        return false;
-
-    if (empty())
-        return str.empty();
-
-    // if both strings have the same length and are non-empty, then we can compare as a prefix.
-    return is_sameprefix(str, checkcase);
+    return ttlib::is_sameas(*this, str, checkcase);
 }
 
 bool cstr::is_sameprefix(std::string_view str, CASE checkcase) const
 {
-    if (str.empty())
-        return empty();
-
-    if (empty() || length() < str.length())
-        return false;
-
-    if (checkcase == CASE::exact)
-    {
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (*iterMain++ != iterSub)
-                return false;
-        }
-        return true;
-    }
-    else if (checkcase == CASE::either)
-    {
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (std::tolower(*iterMain++) != std::tolower(iterSub))
-                return false;
-        }
-        return true;
-    }
-    else if (checkcase == CASE::utf8)
-    {
-        auto utf8locale = std::locale("en_US.utf8");
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (std::tolower(*iterMain++, utf8locale) != std::tolower(iterSub, utf8locale))
-                return false;
-        }
-        return true;
-    }
-    assert(!"Unknown CASE value");
-    return false;
+    return ttlib::is_sameprefix(*this, str, checkcase);
 }
 
 int cstr::comparei(std::string_view str) const
@@ -103,16 +60,11 @@ cstr& cstr::trim(tt::TRIM where)
     if (where == tt::TRIM::right || where == tt::TRIM::both)
     {
         auto len = length();
-        for (--len; len != std::string::npos; --len)
-        {
-            // char ch = at(len);
-            char ch = c_str()[len];
-            if (ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n' && ch != '\f')
-                break;
-        }
+        while (len > 0 && ttlib::is_whitespace(c_str()[len - 1]))
+            --len;
 
-        if (len + 1 < length())
-            erase(len + 1, length() - len);
+        if (len < length())
+            erase(len);
     }
 
     // If trim(right) was called above, the string may now be empty -- front() fails on an empty string
@@ -123,13 +75,8 @@ cstr& cstr::trim(tt::TRIM where)
         if (!ttlib::is_whitespace(front()))
             return *this;
 
-        size_t pos;
-        for (pos = 1; pos < length(); ++pos)
-        {
-            if (!ttlib::is_whitespace(c_str()[pos]))
-                break;
-        }
-        replace(0, length(), substr(pos, length() - pos));
+        auto pos = ttlib::find_nonspace_pos(*this);
+        erase(0, pos != tt::npos ? pos : length());
     }
 
     return *this;
@@ -350,84 +297,24 @@ size_t cstr::locate(std::string_view str, size_t posStart, CASE checkcase) const
     if (checkcase == CASE::exact)
         return find(str, posStart);
 
-    if (checkcase == CASE::either)
-    {
-        auto chLower = std::tolower(str[0]);
-        for (auto pos = posStart; pos < length(); ++pos)
-        {
-            if (std::tolower(at(pos)) == chLower)
-            {
-                size_t posSub;
-                for (posSub = 1; posSub < str.length(); ++posSub)
-                {
-                    if (pos + posSub >= length())
-                        return npos;
-                    if (std::tolower(at(pos + posSub)) != std::tolower(str.at(posSub)))
-                        break;
-                }
-                if (posSub >= str.length())
-                    return pos;
-            }
-        }
-    }
-    else
-    {
-        auto utf8locale = std::locale("en_US.utf8");
-        auto chLower = std::tolower(str[0], utf8locale);
-        for (auto pos = posStart; pos < length(); ++pos)
-        {
-            if (std::tolower(at(pos), utf8locale) == chLower)
-            {
-                size_t posSub;
-                for (posSub = 1; posSub < str.length(); ++posSub)
-                {
-                    if (pos + posSub >= length())
-                        return npos;
-                    if (std::tolower(at(pos + posSub), utf8locale) != std::tolower(str.at(posSub), utf8locale))
-                        break;
-                }
-                if (posSub >= str.length())
-                    return pos;
-            }
-        }
-    }
-    return npos;
+    auto pos = ttlib::findstr_pos<CASE::either>(subview(posStart), str);
+    return (pos == npos) ? npos : pos + posStart;
 }
 
-size_t cstr::get_hash() const noexcept
+size_t cstr::get_hash(tt::CASE checkcase) const noexcept
 {
-    if (empty())
-        return 0;
-
-    // djb2 hash algorithm
-
-    size_t hash = 5381;
-
-    for (auto iter: *this)
-    {
-        hash = ((hash << 5) + hash) ^ iter;
-    }
-
-    return hash;
+    return static_cast<size_t>(ttlib::get_hash(*this, checkcase));
 }
 
 cstr& cstr::MakeLower()
 {
-    auto utf8locale = std::locale("en_US.utf8");
-    for (auto iter = begin(); iter != end(); ++iter)
-    {
-        *iter = std::tolower(*iter, utf8locale);
-    }
+    ttlib::make_lower(*this);
     return *this;
 }
 
 cstr& cstr::MakeUpper()
 {
-    auto utf8locale = std::locale("en_US.utf8");
-    for (auto iter = begin(); iter != end(); ++iter)
-    {
-        *iter = std::toupper(*iter, utf8locale);
-    }
+    ttlib::make_upper(*this);
     return *this;
 }
 
@@ -636,16 +523,21 @@ cstr& cstr::make_relative(std::string_view relative_to)
     if (empty())
         return *this;
 
-#ifdef _WIN32
-    auto current = std::filesystem::absolute(std::filesystem::path(to_utf16()));
-    auto rel_to = std::filesystem::absolute(std::filesystem::path(ttlib::utf8to16(relative_to)));
-    clear();
-    ttlib::utf16to8(current.lexically_relative(rel_to).wstring(), *this);
-#else
-    auto current = std::filesystem::absolute(std::filesystem::path(c_str()));
-    auto rel_to = std::filesystem::absolute(std::filesystem::path(std::string(relative_to)));
-    assign(current.lexically_relative(rel_to).string());
-#endif
+    // The buffers are reused on every call, so once they are large enough nothing is allocated.
+    thread_local std::string result;
+    if (!ttlib::path_relative(*this, relative_to, result))
+    {
+        // One path is absolute and the other isn't, or relative_to is above the current directory,
+        // so both paths need to be absolute. If they are on different drives, the absolute path is
+        // the only way to refer to this one.
+        thread_local std::string abs_path;
+        thread_local std::string abs_base;
+        ttlib::path_absolute(*this, abs_path);
+        ttlib::path_absolute(relative_to, abs_base);
+        if (!ttlib::path_relative(abs_path, abs_base, result))
+            result = abs_path;
+    }
+    assign(result);
     return *this;
 }
 
@@ -653,40 +545,21 @@ cstr& cstr::make_absolute()
 {
     if (!empty())
     {
-#ifdef _WIN32
-        auto current = std::filesystem::path(to_utf16());
-        clear();
-        ttlib::utf16to8(std::filesystem::absolute(current).wstring(), *this);
-#else
-        auto current = std::filesystem::path(c_str());
-        assign(std::filesystem::absolute(current).string());
-#endif
+        thread_local std::string result;
+        ttlib::path_absolute(*this, result);
+        assign(result);
     }
     return *this;
 }
 
 bool cstr::file_exists() const
 {
-    if (empty())
-        return false;
-#ifdef _WIN32
-    auto file = std::filesystem::directory_entry(std::filesystem::path(to_utf16()));
-#else
-    auto file = std::filesystem::directory_entry(std::filesystem::path(c_str()));
-#endif
-    return (file.exists() && !file.is_directory());
+    return ttlib::file_exists(*this);
 }
 
 bool cstr::dir_exists() const
 {
-    if (empty())
-        return false;
-#ifdef _WIN32
-    auto file = std::filesystem::directory_entry(std::filesystem::path(to_utf16()));
-#else
-    auto file = std::filesystem::directory_entry(std::filesystem::path(c_str()));
-#endif
-    return (file.exists() && file.is_directory());
+    return ttlib::dir_exists(*this);
 }
 
 size_t cstr::find_oneof(const char* pszSet) const
@@ -714,20 +587,16 @@ size_t cstr::find_space(size_t start) const
 {
     if (start >= length())
         return npos;
-    const char* pszFound = std::strpbrk(c_str() + start, " \t\r\n\f");
-    if (!pszFound)
-        return npos;
-    return (static_cast<size_t>(pszFound - c_str()));
+    auto pos = ttlib::find_space_pos(subview(start));
+    return (pos != npos ? start + pos : npos);
 }
 
 size_t cstr::find_nonspace(size_t start) const
 {
-    for (; start < length(); ++start)
-    {
-        if (!std::strchr(" \t\r\n\f", at(start)))
-            break;
-    }
-    return start;
+    if (start >= length())
+        return start;
+    auto pos = ttlib::find_nonspace_pos(subview(start));
+    return (pos != npos ? start + pos : length());
 }
 
 size_t cstr::stepover(size_t start) const
@@ -223,8 +223,9 @@ namespace ttlib
             return *this;
         }
 
-        /// Generates hash of current string using djb2 hash algorithm
-        size_t get_hash() const noexcept;
+        /// Generates a hash of the current string (see ttlib::get_hash). Strings that differ only
+        /// in ASCII case generate the same hash if checkcase is CASE::either or CASE::utf8.
+        size_t get_hash(tt::CASE checkcase = tt::CASE::exact) const noexcept;
 
         /// Convert the entire string to lower case. Assumes the string is UTF8.
         cstr& MakeLower();
@@ -312,10 +313,12 @@ namespace ttlib
         /// directory. Supplied path should not contain a filename.
         ///
         /// Unlike fs::relative(), this will not resolve symbolic links, allowing it to work
-        /// even when you are using a directory with a symbolic link to a different drive.
+        /// even when you are using a directory with a symbolic link to a different drive. The
+        /// current directory is only read if one path is absolute and the other isn't. See
+        /// ttlib::path_relative() in ttpath_wx.h.
         cstr& make_relative(std::string_view relative_to);
 
-        /// Changes any current path to an absolute path.
+        /// Changes any current path to a normalized absolute path that uses '/' as the separator.
         cstr& make_absolute();
 
         /// Replaces current string with the full path to the current working directory.
@@ -379,3 +382,10 @@ namespace ttlib
     };  // end cstr class
 
 }  // namespace ttlib
+
+// Allows ttlib::cstr to be used as a key in std::unordered_map and std::unordered_set
+template <>
+struct std::hash<ttlib::cstr>
+{
+    size_t operator()(const ttlib::cstr& str) const noexcept { return str.get_hash(); }
+};
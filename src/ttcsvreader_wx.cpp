@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Streaming reader for CSV and TSV data
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>  // memchr
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttcsvreader_wx.h>
+#include <tttextfile_wx.h>  // textfile -- Classes for reading and writing line-oriented files
+
+using namespace ttlib;
+
+csvreader::csvreader(std::string_view buffer, char delimiter, char quote) :
+    m_buffer(buffer), m_stops { delimiter, '\n', '\r' }, m_quote(quote)
+{
+    rewind();
+}
+
+csvreader::csvreader(ttlib::viewfile& file, char delimiter, char quote) : csvreader(file.GetBuffer(), delimiter, quote)
+{
+}
+
+void csvreader::rewind()
+{
+    m_pos = 0;
+    if (m_buffer.size() >= 3 && m_buffer[0] == static_cast<char>(0xEF) && m_buffer[1] == static_cast<char>(0xBB) &&
+        m_buffer[2] == static_cast<char>(0xBF))
+    {
+        m_pos = 3;
+    }
+    m_row = 0;
+    m_row_offset = m_pos;
+    m_fields.clear();
+    m_unescaped_used = 0;
+    m_malformed = false;
+}
+
+bool csvreader::next_row()
+{
+    m_fields.clear();
+    m_unescaped_used = 0;
+    m_malformed = false;
+    if (m_pos >= m_buffer.size())
+        return false;
+
+    ++m_row;
+    m_row_offset = m_pos;
+    std::string_view stops(m_stops, sizeof(m_stops));
+    auto pos = m_pos;
+    for (;;)
+    {
+        if (pos < m_buffer.size() && m_buffer[pos] == m_quote)
+        {
+            pos = parse_quoted(pos);
+        }
+        else
+        {
+            auto end = ttlib::find_oneof_pos(m_buffer.substr(pos), stops);
+            end = (end == tt::npos) ? m_buffer.size() : pos + end;
+            m_fields.emplace_back(m_buffer.data() + pos, end - pos);
+            pos = end;
+        }
+
+        if (pos >= m_buffer.size())
+        {
+            m_pos = m_buffer.size();
+            return true;
+        }
+
+        if (m_buffer[pos] == m_stops[0])
+        {
+            ++pos;
+            continue;
+        }
+
+        // The field ended with a line break, which also ends the row.
+        if (m_buffer[pos] == '\r' && pos + 1 < m_buffer.size() && m_buffer[pos + 1] == '\n')
+            ++pos;
+        m_pos = pos + 1;
+        return true;
+    }
+}
+
+// pos is the position of the opening quote. Adds the field and returns the position after it.
+size_t csvreader::parse_quoted(size_t pos)
+{
+    auto begin = ++pos;
+    bool has_escapes = false;
+    size_t end;
+    for (;;)
+    {
+        auto found = static_cast<const char*>(std::memchr(m_buffer.data() + pos, m_quote, m_buffer.size() - pos));
+        if (!found)
+        {
+            // No closing quote, so the rest of the buffer is the field.
+            m_malformed = true;
+            end = pos = m_buffer.size();
+            break;
+        }
+        pos = static_cast<size_t>(found - m_buffer.data());
+        if (pos + 1 < m_buffer.size() && m_buffer[pos + 1] == m_quote)
+        {
+            has_escapes = true;
+            pos += 2;
+            continue;
+        }
+        end = pos++;
+        break;
+    }
+
+    // Anything between the closing quote and the next delimiter is kept as part of the field.
+    auto trailing = pos;
+    if (pos < m_buffer.size())
+    {
+        auto stop = ttlib::find_oneof_pos(m_buffer.substr(pos), std::string_view(m_stops, sizeof(m_stops)));
+        trailing = (stop == tt::npos) ? m_buffer.size() : pos + stop;
+        if (trailing != pos)
+            m_malformed = true;
+    }
+
+    if (!has_escapes && trailing == pos)
+    {
+        m_fields.emplace_back(m_buffer.data() + begin, end - begin);
+        return pos;
+    }
+
+    auto& field = unescape_buffer();
+    for (auto ptr = begin; ptr < end; ++ptr)
+    {
+        field.push_back(m_buffer[ptr]);
+        if (m_buffer[ptr] == m_quote)
+            ++ptr;  // skip the second quote of the pair
+    }
+    field.append(m_buffer.substr(pos, trailing - pos));
+    m_fields.emplace_back(field);
+    return trailing;
+}
+
+ttlib::cstr& csvreader::unescape_buffer()
+{
+    if (m_unescaped_used == m_unescaped.size())
+        m_unescaped.emplace_back();
+    auto& str = m_unescaped[m_unescaped_used++];
+    str.clear();
+    return str;
+}
@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Streaming reader for CSV and TSV data
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttcsvreader_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::csvreader reads one row at a time from a buffer containing comma-separated (or any
+/// other single-character delimited) data. Unlike splitting each line of a ttlib::viewfile with
+/// ttlib::multiview, quoted fields may contain delimiters, doubled quotes and line breaks.
+///
+///     ttlib::viewfile file;
+///     if (file.ReadFile("export.csv"))
+///     {
+///         ttlib::csvreader reader(file);
+///         while (reader.next_row())
+///         {
+///             if (reader.size() > 2 && reader[2].is_sameas("active"))
+///                 ...
+///         }
+///     }
+///
+/// Fields are returned as a ttlib::sview into the buffer. The only time a field is copied is when
+/// it contains a doubled quote, in which case the unescaped copy is stored in a string that is
+/// reused for later rows. Only the current row is stored, so memory use does not grow with the
+/// size of the buffer. Fields are only valid until the next call to next_row().
+///
+/// Rows can end with \n, \r\n or \r. A UTF-8 BOM at the start of the buffer is skipped.
+
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#include "ttcstr_wx.h"   // cstr -- std::string with additional methods
+#include "ttsview_wx.h"  // sview -- std::string_view with additional methods
+
+namespace ttlib
+{
+    class viewfile;
+
+    class csvreader
+    {
+    public:
+        /// The buffer must remain valid and unchanged while the reader is in use. Use '\t' as the
+        /// delimiter for TSV data.
+        csvreader(std::string_view buffer, char delimiter = ',', char quote = '"');
+
+        /// Reads the buffer returned by file.GetBuffer().
+        csvreader(ttlib::viewfile& file, char delimiter = ',', char quote = '"');
+
+        /// Parses the next row, returning false if there are no more rows.
+        bool next_row();
+
+        /// Returns the number of fields in the current row.
+        size_t size() const { return m_fields.size(); }
+
+        ttlib::sview operator[](size_t pos) const { return m_fields[pos]; }
+
+        /// Returns all of the fields in the current row.
+        const std::vector<ttlib::sview>& fields() const { return m_fields; }
+
+        auto begin() const { return m_fields.begin(); }
+        auto end() const { return m_fields.end(); }
+
+        /// Returns the number of rows read so far (the 1-based number of the current row).
+        size_t row() const { return m_row; }
+
+        /// Returns the buffer offset of the start of the current row.
+        size_t row_offset() const { return m_row_offset; }
+
+        /// Returns true if the current row has a quoted field with no closing quote, or with
+        /// characters between the closing quote and the next delimiter.
+        bool is_malformed() const { return m_malformed; }
+
+        /// Starts reading from the beginning of the buffer again.
+        void rewind();
+
+    protected:
+        size_t parse_quoted(size_t pos);
+
+        // Returns a cleared string that is not being used by any field in the current row.
+        ttlib::cstr& unescape_buffer();
+
+    private:
+        std::string_view m_buffer;
+        size_t m_pos { 0 };
+        size_t m_row { 0 };
+        size_t m_row_offset { 0 };
+
+        std::vector<ttlib::sview> m_fields;
+
+        // A deque is used so that adding a string doesn't move the strings that fields point to.
+        std::deque<ttlib::cstr> m_unescaped;
+        size_t m_unescaped_used { 0 };
+
+        char m_stops[3];  // delimiter, '\n' and '\r'
+        char m_quote;
+        bool m_malformed { false };
+    };
+}  // namespace ttlib
@@ -12,43 +12,52 @@
 using namespace ttlib;
 using namespace tt;
 
+namespace
+{
+    // Returns the position of the first string at or after start where match(string) is true.
+    // Callers pass a lambda that calls one of the CASE templates so that the comparison is
+    // chosen once rather than for every string.
+    template <typename Match>
+    size_t find_match(const cstrVector& vec, size_t start, Match match)
+    {
+        for (; start < vec.size(); ++start)
+        {
+            if (match(vec[start]))
+                return start;
+        }
+        return tt::npos;
+    }
+}  // anonymous namespace
+
 size_t cstrVector::find(size_t start, std::string_view str, CASE checkcase) const
 {
-    for (; start < size(); ++start)
+    if (checkcase == CASE::exact)
     {
-        if (ttlib::is_sameas(at(start), str, checkcase))
-            return start;
+        return find_match(*this, start,
+                          [str](std::string_view entry) { return ttlib::is_sameas<CASE::exact>(entry, str); });
     }
-    return tt::npos;
+    return find_match(*this, start,
+                      [str](std::string_view entry) { return ttlib::is_sameas<CASE::either>(entry, str); });
 }
 
 size_t cstrVector::findprefix(size_t start, std::string_view str, CASE checkcase) const
 {
     if (checkcase == CASE::exact)
     {
-        for (; start < size(); ++start)
-        {
-            if (ttlib::is_sameprefix(at(start), str, checkcase))
-                return start;
-        }
-    }
-    else
-    {
-        for (; start < size(); ++start)
-        {
-            if (ttlib::is_sameprefix(at(start), str, checkcase))
-                return start;
-        }
+        return find_match(*this, start,
+                          [str](std::string_view entry) { return ttlib::is_sameprefix<CASE::exact>(entry, str); });
     }
-    return tt::npos;
+    return find_match(*this, start,
+                      [str](std::string_view entry) { return ttlib::is_sameprefix<CASE::either>(entry, str); });
 }
 
 size_t cstrVector::contains(size_t start, std::string_view str, CASE checkcase) const
 {
-    for (; start < size(); ++start)
+    if (checkcase == CASE::exact)
     {
-        if (ttlib::contains(at(start), str, checkcase))
-            return start;
+        return find_match(*this, start,
+                          [str](std::string_view entry) { return ttlib::contains<CASE::exact>(entry, str); });
     }
-    return tt::npos;
+    return find_match(*this, start,
+                      [str](std::string_view entry) { return ttlib::contains<CASE::either>(entry, str); });
 }
@@ -16,6 +16,10 @@
 /// The ttlib::cstrVector class stores ttlib::cstr (zero-terminated char containter class) strings. It inherits
 /// from std::vector, providing all of the functionality of std::vector along with some functionality specific to
 /// string handling. It can be used in most places where std::vector<std::string> is used.
+///
+/// find(), append(), addfilename() and has_filename() compare every string. If the vector will hold a large
+/// number of strings and is searched often, use ttlib::strset (ttstrset_wx.h) instead -- it keeps a hash index of
+/// its strings, and since it controls every change to its strings the index can't become out of date.
 
 #include <vector>
 
@@ -34,7 +38,9 @@ namespace ttlib
         bool bfind(size_type pos, std::string_view str) const { return (at(pos).find(str) != tt::npos); }
 
         template <typename T>
-        /// Only adds the string if it doesn't already exist.
+        /// Only adds the string if it doesn't already exist. Every string is compared, so building
+        /// a large list this way is O(N^2) -- ttlib::strset::append() does the same with a hash
+        /// lookup.
         ttlib::cstr& append(T str, tt::CASE checkcase = tt::CASE::exact)
         {
             if (auto index = find(0, str, checkcase); ttlib::is_found(index))
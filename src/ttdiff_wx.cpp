@@ -0,0 +1,438 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Line-based difference between two files or string vectors
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>  // uint32_t
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttdiff_wx.h>
+
+using namespace ttlib;
+
+namespace
+{
+    // Finds the shortest edit script between two sequences of line ids using the linear space
+    // variation of the Myers algorithm, marking every line that is not part of the longest
+    // common subsequence as changed.
+    class myers
+    {
+    public:
+        myers(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<bool>& changed_a,
+              std::vector<bool>& changed_b) :
+            m_a(a), m_b(b), m_changed_a(changed_a), m_changed_b(changed_b)
+        {
+            auto diagonals = a.size() + b.size() + 3;
+            m_forward.resize(diagonals);
+            m_backward.resize(diagonals);
+
+            // Roughly the square root of the number of diagonals (the same as GNU diff), but never
+            // less than 256. Each search costs up to m_max_cost squared steps and may only advance
+            // m_max_cost lines, so a fixed limit would make heavily reordered input far slower.
+            m_max_cost = 1;
+            for (auto count = diagonals; count > 3; count >>= 2)
+                m_max_cost <<= 1;
+            m_max_cost = std::max<ptrdiff_t>(m_max_cost, 256);
+        }
+
+        void compare(size_t xoff, size_t xlim, size_t yoff, size_t ylim);
+
+    protected:
+        // Returns the point where the middle snake of the shortest edit script begins or ends.
+        std::pair<size_t, size_t> middle(size_t xoff, size_t xlim, size_t yoff, size_t ylim);
+
+    private:
+        const std::vector<uint32_t>& m_a;
+        const std::vector<uint32_t>& m_b;
+        std::vector<bool>& m_changed_a;
+        std::vector<bool>& m_changed_b;
+
+        // Furthest x reached on each diagonal, indexed by k + m_b.size() + 1
+        std::vector<ptrdiff_t> m_forward;
+        std::vector<ptrdiff_t> m_backward;
+
+        // Once a search has gone this many steps without the two ends meeting, it gives up on the
+        // smallest possible script and splits at the furthest point reached.
+        ptrdiff_t m_max_cost;
+    };
+
+    void myers::compare(size_t xoff, size_t xlim, size_t yoff, size_t ylim)
+    {
+        for (;;)
+        {
+            while (xoff < xlim && yoff < ylim && m_a[xoff] == m_b[yoff])
+            {
+                ++xoff;
+                ++yoff;
+            }
+            while (xlim > xoff && ylim > yoff && m_a[xlim - 1] == m_b[ylim - 1])
+            {
+                --xlim;
+                --ylim;
+            }
+
+            if (xoff == xlim)
+            {
+                for (; yoff < ylim; ++yoff)
+                    m_changed_b[yoff] = true;
+                return;
+            }
+            if (yoff == ylim)
+            {
+                for (; xoff < xlim; ++xoff)
+                    m_changed_a[xoff] = true;
+                return;
+            }
+
+            auto [xmid, ymid] = middle(xoff, xlim, yoff, ylim);
+
+            // Recurse into the smaller half and loop on the larger one to limit the stack depth.
+            if ((xmid - xoff) + (ymid - yoff) < (xlim - xmid) + (ylim - ymid))
+            {
+                compare(xoff, xmid, yoff, ymid);
+                xoff = xmid;
+                yoff = ymid;
+            }
+            else
+            {
+                compare(xmid, xlim, ymid, ylim);
+                xlim = xmid;
+                ylim = ymid;
+            }
+        }
+    }
+
+    std::pair<size_t, size_t> myers::middle(size_t xoff, size_t xlim, size_t yoff, size_t ylim)
+    {
+        // Diagonal k is x - y in coordinates relative to (xoff, yoff). The backward search uses
+        // coordinates relative to (xlim, ylim) measured towards the start, so the same point is on
+        // backward diagonal delta - k.
+        const auto N = static_cast<ptrdiff_t>(xlim - xoff);
+        const auto M = static_cast<ptrdiff_t>(ylim - yoff);
+        const auto delta = N - M;
+        const bool odd = (delta & 1) != 0;
+        const auto offset = static_cast<ptrdiff_t>(m_b.size()) + 1;
+
+        auto* fwd = m_forward.data() + offset;
+        auto* bwd = m_backward.data() + offset;
+
+        const auto* a = m_a.data() + xoff;
+        const auto* b = m_b.data() + yoff;
+
+        // Diagonals searched in the previous step -- only these have valid values in fwd and bwd.
+        ptrdiff_t prev_min = 1;
+        ptrdiff_t prev_max = -1;
+
+        for (ptrdiff_t d = 0; d <= (N + M + 1) / 2; ++d)
+        {
+            // Only diagonals that stay within the rectangle need to be searched.
+            auto kmin = -std::min(d, M);
+            auto kmax = std::min(d, N);
+            if ((kmin + d) & 1)
+                ++kmin;
+            if ((kmax + d) & 1)
+                --kmax;
+
+            for (auto k = kmin; k <= kmax; k += 2)
+            {
+                ptrdiff_t x;
+                if (d == 0)
+                    x = 0;
+                else if (k - 1 < prev_min || (k + 1 <= prev_max && fwd[k - 1] < fwd[k + 1]))
+                    x = fwd[k + 1];
+                else
+                    x = fwd[k - 1] + 1;
+                x = std::min(x, std::min(N, k + M));  // stay inside the rectangle
+                ptrdiff_t y = x - k;
+                while (x < N && y < M && a[x] == b[y])
+                {
+                    ++x;
+                    ++y;
+                }
+                fwd[k] = x;
+
+                if (odd && delta - k >= prev_min && delta - k <= prev_max && x + bwd[delta - k] >= N)
+                    return { xoff + static_cast<size_t>(x), yoff + static_cast<size_t>(y) };
+            }
+
+            for (auto k = kmin; k <= kmax; k += 2)
+            {
+                ptrdiff_t u;
+                if (d == 0)
+                    u = 0;
+                else if (k - 1 < prev_min || (k + 1 <= prev_max && bwd[k - 1] < bwd[k + 1]))
+                    u = bwd[k + 1];
+                else
+                    u = bwd[k - 1] + 1;
+                u = std::min(u, std::min(N, k + M));
+                ptrdiff_t v = u - k;
+                while (u < N && v < M && a[N - u - 1] == b[M - v - 1])
+                {
+                    ++u;
+                    ++v;
+                }
+                bwd[k] = u;
+
+                if (!odd && delta - k >= kmin && delta - k <= kmax && u + fwd[delta - k] >= N)
+                    return { xlim - static_cast<size_t>(u), ylim - static_cast<size_t>(v) };
+            }
+
+            prev_min = kmin;
+            prev_max = kmax;
+
+            if (d >= m_max_cost)
+            {
+                // Split at the forward diagonal that reached the furthest. The result is still a
+                // correct script, it just may not be the smallest one.
+                auto best = kmin;
+                for (auto k = kmin + 2; k <= kmax; k += 2)
+                {
+                    if (2 * fwd[k] - k > 2 * fwd[best] - best)
+                        best = k;
+                }
+                return { xoff + static_cast<size_t>(fwd[best]), yoff + static_cast<size_t>(fwd[best] - best) };
+            }
+        }
+
+        // Not reachable -- the searches always meet by the time d reaches (N + M + 1) / 2.
+        return { xlim, ylim };
+    }
+}  // anonymous namespace
+
+std::vector<ttlib::diff_change> ttlib::diff_lines(const std::vector<std::string_view>& a,
+                                                  const std::vector<std::string_view>& b, tt::CASE checkcase)
+{
+    std::vector<ttlib::diff_change> changes;
+
+    // Lines that are the same at the start and end of both files are never part of a change.
+    size_t prefix = 0;
+    while (prefix < a.size() && prefix < b.size() && ttlib::is_sameas(a[prefix], b[prefix], checkcase))
+        ++prefix;
+    size_t suffix = 0;
+    while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+           ttlib::is_sameas(a[a.size() - suffix - 1], b[b.size() - suffix - 1], checkcase))
+    {
+        ++suffix;
+    }
+
+    const auto size_a = a.size() - prefix - suffix;
+    const auto size_b = b.size() - prefix - suffix;
+    if (!size_a && !size_b)
+        return changes;
+
+    // Replace each line with an id so that comparing two lines is a single integer comparison.
+    // Lines with the same hash are only given the same id if they really are the same.
+    // The table is open-addressed with at least twice as many slots as lines so that probe runs
+    // stay short. Each slot holds the upper half of the line's hash and id + 1 (zero is an empty
+    // slot), so lines are only compared when their hashes match.
+    size_t slots = 16;
+    while (slots < (size_a + size_b) * 2)
+        slots <<= 1;
+    std::vector<uint64_t> table(slots, 0);
+    std::vector<std::string_view> id_lines;
+    auto get_id = [&](std::string_view line)
+    {
+        auto hash = ttlib::get_hash(line, checkcase);
+        auto tag = hash & 0xFFFFFFFF00000000ull;
+        for (auto slot = static_cast<size_t>(hash) & (slots - 1);; slot = (slot + 1) & (slots - 1))
+        {
+            if (!table[slot])
+            {
+                id_lines.push_back(line);
+                table[slot] = tag | id_lines.size();
+                return static_cast<uint32_t>(id_lines.size() - 1);
+            }
+            if ((table[slot] & 0xFFFFFFFF00000000ull) == tag)
+            {
+                auto id = static_cast<uint32_t>(table[slot]) - 1;
+                if (ttlib::is_sameas(id_lines[id], line, checkcase))
+                    return id;
+            }
+        }
+    };
+
+    std::vector<uint32_t> ids_a(size_a);
+    for (size_t pos = 0; pos < size_a; ++pos)
+        ids_a[pos] = get_id(a[prefix + pos]);
+    const auto count_a_ids = id_lines.size();
+    std::vector<uint32_t> ids_b(size_b);
+    for (size_t pos = 0; pos < size_b; ++pos)
+        ids_b[pos] = get_id(b[prefix + pos]);
+
+    // A line that only appears in one file can't be part of the common subsequence, so it is
+    // marked as changed without being searched. For files that are very different, this removes
+    // most of the lines that would otherwise make the search slow.
+    std::vector<bool> in_a(id_lines.size(), false);
+    std::vector<bool> in_b(id_lines.size(), false);
+    for (auto id: ids_a)
+        in_a[id] = true;
+    for (auto id: ids_b)
+        in_b[id] = true;
+
+    std::vector<bool> changed_a(size_a, false);
+    std::vector<bool> changed_b(size_b, false);
+    std::vector<uint32_t> search_a, search_b;
+    std::vector<size_t> lines_a, lines_b;  // line in ids_a/ids_b of each entry in search_a/search_b
+    search_a.reserve(size_a);
+    lines_a.reserve(size_a);
+    for (size_t pos = 0; pos < size_a; ++pos)
+    {
+        if (in_b[ids_a[pos]])
+        {
+            search_a.push_back(ids_a[pos]);
+            lines_a.push_back(pos);
+        }
+        else
+        {
+            changed_a[pos] = true;
+        }
+    }
+    search_b.reserve(size_b);
+    lines_b.reserve(size_b);
+    for (size_t pos = 0; pos < size_b; ++pos)
+    {
+        // Every id >= count_a_ids was first seen in b, so it can't be in a.
+        if (ids_b[pos] < count_a_ids && in_a[ids_b[pos]])
+        {
+            search_b.push_back(ids_b[pos]);
+            lines_b.push_back(pos);
+        }
+        else
+        {
+            changed_b[pos] = true;
+        }
+    }
+
+    {
+        std::vector<bool> search_changed_a(search_a.size(), false);
+        std::vector<bool> search_changed_b(search_b.size(), false);
+        myers search(search_a, search_b, search_changed_a, search_changed_b);
+        search.compare(0, search_a.size(), 0, search_b.size());
+        for (size_t pos = 0; pos < search_a.size(); ++pos)
+        {
+            if (search_changed_a[pos])
+                changed_a[lines_a[pos]] = true;
+        }
+        for (size_t pos = 0; pos < search_b.size(); ++pos)
+        {
+            if (search_changed_b[pos])
+                changed_b[lines_b[pos]] = true;
+        }
+    }
+
+    // Unchanged lines in a and b are matched in order, so walking both at once turns each run of
+    // changed lines into a single change.
+    size_t pos_a = 0;
+    size_t pos_b = 0;
+    while (pos_a < size_a || pos_b < size_b)
+    {
+        if (pos_a < size_a && pos_b < size_b && !changed_a[pos_a] && !changed_b[pos_b])
+        {
+            ++pos_a;
+            ++pos_b;
+            continue;
+        }
+
+        auto& change = changes.emplace_back();
+        change.line_a = prefix + pos_a;
+        change.line_b = prefix + pos_b;
+        while (pos_a < size_a && changed_a[pos_a])
+            ++pos_a;
+        while (pos_b < size_b && changed_b[pos_b])
+            ++pos_b;
+        change.count_a = prefix + pos_a - change.line_a;
+        change.count_b = prefix + pos_b - change.line_b;
+    }
+
+    return changes;
+}
+
+namespace
+{
+    // Formats a hunk range the way diff -u does: a single line is just the line number, and an
+    // empty range uses the number of the line before it.
+    void append_range(std::string& out, size_t start, size_t count)
+    {
+        out += std::to_string(count ? start + 1 : start);
+        if (count != 1)
+        {
+            out += ',';
+            out += std::to_string(count);
+        }
+    }
+}  // anonymous namespace
+
+void ttlib::unified_diff_lines(std::string& out, const std::vector<std::string_view>& a,
+                               const std::vector<std::string_view>& b, const std::vector<ttlib::diff_change>& changes,
+                               std::string_view name_a, std::string_view name_b, size_t context)
+{
+    if (changes.empty())
+        return;
+
+    out += "--- ";
+    out += name_a;
+    out += "\n+++ ";
+    out += name_b;
+    out += '\n';
+
+    for (size_t first = 0; first < changes.size();)
+    {
+        // Changes that are close enough for their context lines to touch are combined into one
+        // hunk.
+        auto last = first;
+        while (last + 1 < changes.size() &&
+               changes[last + 1].line_a - (changes[last].line_a + changes[last].count_a) <= context * 2)
+        {
+            ++last;
+        }
+
+        auto start_a = changes[first].line_a - std::min(changes[first].line_a, context);
+        auto start_b = changes[first].line_b - (changes[first].line_a - start_a);
+        auto end_a = std::min(a.size(), changes[last].line_a + changes[last].count_a + context);
+        auto end_b =
+            changes[last].line_b + changes[last].count_b + (end_a - (changes[last].line_a + changes[last].count_a));
+
+        out += "@@ -";
+        append_range(out, start_a, end_a - start_a);
+        out += " +";
+        append_range(out, start_b, end_b - start_b);
+        out += " @@\n";
+
+        auto pos_a = start_a;
+        for (auto idx = first; idx <= last; ++idx)
+        {
+            auto& change = changes[idx];
+            for (; pos_a < change.line_a; ++pos_a)
+            {
+                out += ' ';
+                out += a[pos_a];
+                out += '\n';
+            }
+            for (size_t line = 0; line < change.count_a; ++line)
+            {
+                out += '-';
+                out += a[change.line_a + line];
+                out += '\n';
+            }
+            for (size_t line = 0; line < change.count_b; ++line)
+            {
+                out += '+';
+                out += b[change.line_b + line];
+                out += '\n';
+            }
+            pos_a = change.line_a + change.count_a;
+        }
+        for (; pos_a < end_a; ++pos_a)
+        {
+            out += ' ';
+            out += a[pos_a];
+            out += '\n';
+        }
+
+        first = last + 1;
+    }
+}
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Line-based difference between two files or string vectors
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttdiff_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::diff() compares the lines of two ttlib::textfile, ttlib::viewfile or any other vector of
+/// strings, and returns the smallest set of changes needed to turn the first into the second (the
+/// Myers O(ND) algorithm using linear space). ttlib::unified_diff() formats those changes the same
+/// way "diff -u" does:
+///
+///     ttlib::viewfile original, current;
+///     ...
+///     auto changes = ttlib::diff(original, current);
+///     if (changes.size())
+///         ttlib::unified_diff(output, original, current, changes, "a/file.cpp", "b/file.cpp");
+///
+/// Each line is hashed once and replaced with a small integer, so the comparison itself never
+/// compares strings. Lines common to the start and end of both files are removed before searching,
+/// as are lines that only appear in one of the files since those can only be removals or insertions.
+///
+/// Like GNU diff, the search gives up on finding the smallest set of changes once it becomes too
+/// expensive -- after roughly the square root of the total number of lines (at least 256) differences
+/// in a single search. The changes returned are still correct, but may include lines that didn't need
+/// to change. Comparing files with scattered edits stays close to linear, but the worst case (most of
+/// the lines reordered) is about O(N * sqrt(N)): a million shuffled lines can take 5-20 seconds.
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+namespace ttlib
+{
+    /// A single change: count_a lines starting at line_a in the first file are replaced by count_b
+    /// lines starting at line_b in the second file. Line numbers are zero-based. A count of zero
+    /// means lines were only inserted (count_a) or only removed (count_b). Every line outside of a
+    /// change is identical in both files.
+    struct diff_change
+    {
+        size_t line_a;
+        size_t count_a;
+        size_t line_b;
+        size_t count_b;
+    };
+
+    /// Returns the changes needed to turn the lines in a into the lines in b, in line order. An
+    /// empty result means the lines are identical.
+    std::vector<ttlib::diff_change> diff_lines(const std::vector<std::string_view>& a,
+                                               const std::vector<std::string_view>& b,
+                                               tt::CASE checkcase = tt::CASE::exact);
+
+    /// Appends a unified diff ("diff -u" format) of the changes to out. context is the number of
+    /// unchanged lines to show before and after each change.
+    void unified_diff_lines(std::string& out, const std::vector<std::string_view>& a,
+                            const std::vector<std::string_view>& b, const std::vector<ttlib::diff_change>& changes,
+                            std::string_view name_a, std::string_view name_b, size_t context = 3);
+
+    /// Works with ttlib::textfile, ttlib::viewfile, ttlib::multistr, ttlib::cstrVector or any other
+    /// vector of strings.
+    template <class T1, class T2>
+    std::vector<ttlib::diff_change> diff(const std::vector<T1>& a, const std::vector<T2>& b,
+                                         tt::CASE checkcase = tt::CASE::exact)
+    {
+        std::vector<std::string_view> lines_a(a.begin(), a.end());
+        std::vector<std::string_view> lines_b(b.begin(), b.end());
+        return ttlib::diff_lines(lines_a, lines_b, checkcase);
+    }
+
+    /// Appends a unified diff of the changes returned by ttlib::diff(a, b) to out.
+    template <class T1, class T2>
+    void unified_diff(std::string& out, const std::vector<T1>& a, const std::vector<T2>& b,
+                      const std::vector<ttlib::diff_change>& changes, std::string_view name_a, std::string_view name_b,
+                      size_t context = 3)
+    {
+        std::vector<std::string_view> lines_a(a.begin(), a.end());
+        std::vector<std::string_view> lines_b(b.begin(), b.end());
+        ttlib::unified_diff_lines(out, lines_a, lines_b, changes, name_a, name_b, context);
+    }
+}  // namespace ttlib
@@ -0,0 +1,443 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Persistent index of the filenames in a directory tree
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>  // std::sort, std::lower_bound
+#include <cstring>    // memcpy, memcmp, strlen
+#include <filesystem>
+#include <fstream>
+#include <system_error>  // std::error_code
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttdirindex_wx.h>
+#include <ttstrset_wx.h>  // strset -- Hashed set and map of strings with a case policy
+
+using namespace ttlib;
+
+namespace
+{
+    constexpr char index_magic[8] = { 't', 't', 'd', 'i', 'r', 'i', 'd', 'x' };
+
+    std::filesystem::path to_path(std::string_view path)
+    {
+#if defined(_WIN32)
+        std::wstring str16;
+        ttlib::utf8to16(path, str16);
+        return std::filesystem::path(str16);
+#else
+        return std::filesystem::path(path);
+#endif
+    }
+
+    // Returns false if the modification time could not be read.
+    bool get_mtime(const std::filesystem::path& path, int64_t& mtime)
+    {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(path, ec);
+        if (ec)
+            return false;
+        mtime = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    // Returns true if path is rel_dir or one of its subdirectories.
+    bool is_within(std::string_view path, std::string_view rel_dir)
+    {
+        if (rel_dir.empty())
+            return true;
+        return path.size() >= rel_dir.size() && path.compare(0, rel_dir.size(), rel_dir) == 0 &&
+               (path.size() == rel_dir.size() || path[rel_dir.size()] == '/');
+    }
+}  // anonymous namespace
+
+bool dirindex::open(std::string_view root, std::string_view index_file)
+{
+    ttlib::cstr normalized(root);
+    while (normalized.size() > 1 && (normalized.back() == '/' || normalized.back() == '\\'))
+        normalized.pop_back();
+
+    if (load(index_file) && m_root == normalized)
+    {
+        if (refresh())
+            save(index_file);
+        if (file_count() || dir_count())
+            return true;
+    }
+
+    if (!scan(root))
+        return false;
+    save(index_file);
+    return true;
+}
+
+bool dirindex::scan(std::string_view root)
+{
+    m_root.assign(root);
+    while (m_root.size() > 1 && (m_root.back() == '/' || m_root.back() == '\\'))
+        m_root.pop_back();
+
+    std::vector<scanned_dir> dirs;
+    if (m_root.empty() || !scan_tree("", dirs))
+    {
+        m_buffer.clear();
+        return false;
+    }
+    build(dirs);
+    return true;
+}
+
+bool dirindex::refresh()
+{
+    if (m_buffer.empty())
+        return false;
+
+    const auto& hdr = header();
+    std::vector<uint32_t> changed;
+    for (uint32_t idx = 0; idx < hdr.dir_count; ++idx)
+    {
+        int64_t mtime;
+        if (!get_mtime(to_path(full_path(pool() + dirs()[idx].path)), mtime) || mtime != dirs()[idx].mtime)
+            changed.push_back(idx);
+    }
+    if (changed.empty())
+        return false;
+
+    // Something changed, so the directories are unpacked, updated, and then packed into a new
+    // buffer.
+    std::vector<scanned_dir> unpacked(hdr.dir_count);
+    for (uint32_t idx = 0; idx < hdr.dir_count; ++idx)
+    {
+        unpacked[idx].path = pool() + dirs()[idx].path;
+        unpacked[idx].mtime = dirs()[idx].mtime;
+    }
+    for (uint32_t idx = 0; idx < hdr.file_count; ++idx)
+        unpacked[files()[idx].dir].files.emplace_back(pool() + files()[idx].name);
+
+    std::vector<bool> removed(unpacked.size(), false);
+    std::vector<scanned_dir> added;
+    ttlib::strset known;
+    for (auto& iter: unpacked)
+        known.emplace_back(iter.path);
+
+    auto remove_tree = [&](std::string_view rel_path)
+    {
+        for (size_t idx = 0; idx < unpacked.size(); ++idx)
+        {
+            if (!removed[idx] && is_within(unpacked[idx].path, rel_path))
+                removed[idx] = true;
+        }
+    };
+
+    for (auto idx: changed)
+    {
+        if (removed[idx])
+            continue;
+        auto& dir = unpacked[idx];
+        std::vector<ttlib::cstr> subdirs;
+        if (!scan_dir(dir, &subdirs))
+        {
+            // Copy the path since remove_tree() compares it against itself
+            ttlib::cstr path = dir.path;
+            remove_tree(path);
+            continue;
+        }
+
+        // Subdirectories that are no longer in the listing have been removed or renamed.
+        ttlib::strset current;
+        for (auto& iter: subdirs)
+            current.emplace_back(iter);
+        for (size_t child = 0; child < unpacked.size(); ++child)
+        {
+            auto& path = unpacked[child].path;
+            if (removed[child] || child == idx || !is_within(path, dir.path))
+                continue;
+            auto rest = std::string_view(path).substr(dir.path.empty() ? 0 : dir.path.size() + 1);
+            if (rest.find('/') == tt::npos && !current.contains(path))
+            {
+                ttlib::cstr removed_path = path;
+                remove_tree(removed_path);
+            }
+        }
+
+        // Subdirectories that aren't in the index are new, so their entire tree is scanned.
+        for (auto& iter: subdirs)
+        {
+            if (!known.contains(iter))
+                scan_tree(iter, added);
+        }
+    }
+
+    std::vector<scanned_dir> updated;
+    updated.reserve(unpacked.size() + added.size());
+    for (size_t idx = 0; idx < unpacked.size(); ++idx)
+    {
+        if (!removed[idx])
+            updated.emplace_back(std::move(unpacked[idx]));
+    }
+    for (auto& iter: added)
+        updated.emplace_back(std::move(iter));
+    build(updated);
+    return true;
+}
+
+bool dirindex::load(std::string_view index_file)
+{
+    m_buffer.clear();
+    m_root.clear();
+
+    std::ifstream file(to_path(index_file), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+    auto bytes = static_cast<size_t>(file.tellg());
+    if (bytes < sizeof(index_header))
+        return false;
+    file.seekg(0);
+    m_buffer.resize((bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    if (!file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(bytes)) || !is_valid(bytes))
+    {
+        m_buffer.clear();
+        return false;
+    }
+    m_root = pool() + header().root;
+    return true;
+}
+
+bool dirindex::is_valid(size_t bytes) const
+{
+    const auto& hdr = header();
+    if (std::memcmp(hdr.magic, index_magic, sizeof(index_magic)) != 0 || hdr.version != version ||
+        ((hdr.flags & 1) != 0) != (m_case != tt::CASE::exact))
+    {
+        return false;
+    }
+    auto expected = sizeof(index_header) + static_cast<size_t>(hdr.dir_count) * sizeof(dir_record) +
+                    static_cast<size_t>(hdr.file_count) * sizeof(file_record) + hdr.pool_size;
+    if (expected != bytes || !hdr.pool_size || pool()[hdr.pool_size - 1] != 0 || hdr.root >= hdr.pool_size)
+        return false;
+
+    // Every string is null-terminated, so only the offsets need to be checked.
+    for (uint32_t idx = 0; idx < hdr.dir_count; ++idx)
+    {
+        if (dirs()[idx].path >= hdr.pool_size)
+            return false;
+    }
+    for (uint32_t idx = 0; idx < hdr.file_count; ++idx)
+    {
+        if (files()[idx].name >= hdr.pool_size || files()[idx].dir >= hdr.dir_count)
+            return false;
+    }
+    return true;
+}
+
+bool dirindex::save(std::string_view index_file) const
+{
+    if (m_buffer.empty())
+        return false;
+
+    auto path = to_path(index_file);
+    auto temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        auto bytes = sizeof(index_header) + static_cast<size_t>(header().dir_count) * sizeof(dir_record) +
+                     static_cast<size_t>(header().file_count) * sizeof(file_record) + header().pool_size;
+        if (!file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(bytes)))
+            return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::vector<ttlib::cstr> dirindex::find(std::string_view filename) const
+{
+    std::vector<ttlib::cstr> results;
+    if (m_buffer.empty())
+        return results;
+
+    auto hash = ttlib::get_hash(filename, hash_case());
+    auto end = files() + header().file_count;
+    for (auto iter = std::lower_bound(files(), end, hash,
+                                      [](const file_record& record, uint64_t value) { return record.hash < value; });
+         iter != end && iter->hash == hash; ++iter)
+    {
+        if (ttlib::is_sameas(pool() + iter->name, filename, m_case))
+        {
+            auto& path = results.emplace_back(full_path(pool() + dirs()[iter->dir].path));
+            path += '/';
+            path += pool() + iter->name;
+        }
+    }
+    return results;
+}
+
+ttlib::cstr dirindex::find_file(std::string_view filename) const
+{
+    auto results = find(filename);
+    return results.empty() ? ttlib::cstr() : std::move(results[0]);
+}
+
+bool dirindex::has_filename(std::string_view filename) const
+{
+    if (m_buffer.empty())
+        return false;
+
+    auto hash = ttlib::get_hash(filename, hash_case());
+    auto end = files() + header().file_count;
+    for (auto iter = std::lower_bound(files(), end, hash,
+                                      [](const file_record& record, uint64_t value) { return record.hash < value; });
+         iter != end && iter->hash == hash; ++iter)
+    {
+        if (ttlib::is_sameas(pool() + iter->name, filename, m_case))
+            return true;
+    }
+    return false;
+}
+
+ttlib::cstr dirindex::full_path(std::string_view rel_path) const
+{
+    ttlib::cstr path(m_root);
+    if (rel_path.size())
+    {
+        if (path.back() != '/' && path.back() != '\\')
+            path += '/';
+        path += rel_path;
+    }
+    return path;
+}
+
+bool dirindex::scan_tree(std::string_view rel_path, std::vector<scanned_dir>& dirs) const
+{
+    std::vector<ttlib::cstr> pending { ttlib::cstr(rel_path) };
+    bool is_top = true;
+    while (pending.size())
+    {
+        scanned_dir dir;
+        dir.path = std::move(pending.back());
+        pending.pop_back();
+        if (!scan_dir(dir, &pending))
+        {
+            if (is_top)
+                return false;
+            continue;  // a subdirectory that can't be read is left out of the index
+        }
+        is_top = false;
+        dirs.emplace_back(std::move(dir));
+    }
+    return true;
+}
+
+bool dirindex::scan_dir(scanned_dir& dir, std::vector<ttlib::cstr>* subdirs) const
+{
+    auto path = to_path(full_path(dir.path));
+
+    // The time is read before the listing, so a file added while the directory is being read
+    // changes the time again and will be found by the next refresh().
+    if (!get_mtime(path, dir.mtime))
+        return false;
+
+    std::error_code ec;
+    std::filesystem::directory_iterator iter(path, ec);
+    if (ec)
+        return false;
+
+    dir.files.clear();
+    ttlib::cstr name;
+    for (; !ec && iter != std::filesystem::directory_iterator(); iter.increment(ec))
+    {
+        name.clear();
+#if defined(_WIN32)
+        ttlib::utf16to8(iter->path().filename().wstring(), name);
+#else
+        name = iter->path().filename().string();
+#endif
+        std::error_code type_ec;
+        if (iter->is_directory(type_ec))
+        {
+            if (subdirs && !iter->is_symlink(type_ec))
+            {
+                auto& subdir = subdirs->emplace_back(dir.path);
+                if (subdir.size())
+                    subdir += '/';
+                subdir += name;
+            }
+        }
+        else
+        {
+            dir.files.emplace_back(name);
+        }
+    }
+    return !ec;
+}
+
+void dirindex::build(std::vector<scanned_dir>& dirs)
+{
+    // Parent directories are placed before their children, which keeps the order the same no
+    // matter which order the directories were scanned in.
+    std::sort(dirs.begin(), dirs.end(), [](const scanned_dir& a, const scanned_dir& b) { return a.path < b.path; });
+
+    size_t pool_size = m_root.size() + 1;
+    size_t file_count = 0;
+    for (auto& dir: dirs)
+    {
+        pool_size += dir.path.size() + 1;
+        for (auto& name: dir.files)
+            pool_size += name.size() + 1;
+        file_count += dir.files.size();
+    }
+
+    auto bytes = sizeof(index_header) + dirs.size() * sizeof(dir_record) + file_count * sizeof(file_record) + pool_size;
+    m_buffer.assign((bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+
+    auto& hdr = *reinterpret_cast<index_header*>(m_buffer.data());
+    std::memcpy(hdr.magic, index_magic, sizeof(index_magic));
+    hdr.version = version;
+    hdr.flags = (m_case != tt::CASE::exact) ? 1 : 0;
+    hdr.dir_count = static_cast<uint32_t>(dirs.size());
+    hdr.file_count = static_cast<uint32_t>(file_count);
+    hdr.pool_size = static_cast<uint32_t>(pool_size);
+
+    auto* dir_records = reinterpret_cast<dir_record*>(&hdr + 1);
+    auto* file_records = reinterpret_cast<file_record*>(dir_records + dirs.size());
+    auto* strings = reinterpret_cast<char*>(file_records + file_count);
+
+    uint32_t offset = 0;
+    auto add_string = [&](std::string_view str)
+    {
+        auto start = offset;
+        std::memcpy(strings + offset, str.data(), str.size());
+        offset += static_cast<uint32_t>(str.size()) + 1;  // the buffer is zero-filled, so the null is already there
+        return start;
+    };
+
+    hdr.root = add_string(m_root);
+    auto* file = file_records;
+    for (uint32_t idx = 0; idx < dirs.size(); ++idx)
+    {
+        dir_records[idx].mtime = dirs[idx].mtime;
+        dir_records[idx].path = add_string(dirs[idx].path);
+        for (auto& name: dirs[idx].files)
+        {
+            file->hash = ttlib::get_hash(name, hash_case());
+            file->dir = idx;
+            file->name = add_string(name);
+            ++file;
+        }
+    }
+
+    // Sorting by hash is what makes a lookup a binary search. Ties keep the directory order.
+    std::stable_sort(file_records, file_records + file_count,
+                     [](const file_record& a, const file_record& b) { return a.hash < b.hash; });
+}
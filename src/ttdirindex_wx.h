@@ -0,0 +1,154 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Persistent index of the filenames in a directory tree
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttdirindex_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::dirindex scans a directory tree once and saves the name of every file in it to an index
+/// file. Later runs load the index and only re-read the directories whose modification time has
+/// changed, so looking up a filename never needs to walk the tree again:
+///
+///     ttlib::dirindex index;
+///     index.open("src", ".build/src.idx");  // scans src the first time, revalidates after that
+///     if (index.has_filename("resource.h"))
+///         auto paths = index.find("resource.h");
+///
+/// The index file has no pointers in it -- everything is an offset -- so it is used exactly as it
+/// is read, without any parsing. It is only valid on the same type of machine that wrote it.
+///
+/// A directory's modification time changes when a file is added to it, removed from it or renamed,
+/// so revalidating only needs one call to the file system per directory rather than one per file.
+/// Changes to the contents of a file don't affect the index. Symbolic links to directories are not
+/// followed.
+
+#include <cstdint>  // uint32_t, uint64_t
+#include <string_view>
+#include <vector>
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+#include "ttcstr_wx.h"  // cstr -- std::string with additional methods
+
+namespace ttlib
+{
+    class dirindex
+    {
+    public:
+#if defined(_WIN32)
+        // Case-insensitive when compiled for Windows, otherwise case-sensitive
+        dirindex(tt::CASE checkcase = tt::CASE::either) : m_case(checkcase) {}
+#else
+        // Case-insensitive when compiled for Windows, otherwise case-sensitive
+        dirindex(tt::CASE checkcase = tt::CASE::exact) : m_case(checkcase) {}
+#endif
+
+        /// Loads index_file and updates it with any directories under root that have changed. If
+        /// index_file doesn't exist, can't be read, or is for a different root, then root is
+        /// scanned instead. index_file is written if anything changed. Returns false if root
+        /// can't be read.
+        bool open(std::string_view root, std::string_view index_file);
+
+        /// Scans every directory under root, replacing the current index.
+        bool scan(std::string_view root);
+
+        /// Re-reads any directory whose modification time has changed, and any new subdirectories
+        /// found in them. Returns true if the index changed.
+        bool refresh();
+
+        /// Loads an index without checking whether any directories have changed.
+        bool load(std::string_view index_file);
+
+        /// Writes the index to a temporary file and then renames it to index_file, so another
+        /// process reading index_file never sees a partial index.
+        bool save(std::string_view index_file) const;
+
+        /// Returns the path of every file named filename, in no particular order. Each path starts
+        /// with root() and uses '/' to separate directories.
+        std::vector<ttlib::cstr> find(std::string_view filename) const;
+
+        /// Returns the path of one file named filename, or an empty string if there isn't one.
+        ttlib::cstr find_file(std::string_view filename) const;
+
+        bool has_filename(std::string_view filename) const;
+
+        /// The root directory as passed to open() or scan().
+        const ttlib::cstr& root() const { return m_root; }
+
+        size_t dir_count() const { return m_buffer.empty() ? 0 : header().dir_count; }
+        size_t file_count() const { return m_buffer.empty() ? 0 : header().file_count; }
+
+        /// Incremented every time the format of the index file changes.
+        static constexpr uint32_t version = 1;
+
+    protected:
+        // The index file and m_buffer start with this header, followed by dir_count dir_record
+        // entries, file_count file_record entries sorted by hash, and then pool_size bytes of
+        // null-terminated UTF-8 strings.
+        struct index_header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t flags;  // bit 0 is set if names ignore case
+            uint32_t dir_count;
+            uint32_t file_count;
+            uint32_t pool_size;
+            uint32_t root;  // offset in the pool
+        };
+
+        struct dir_record
+        {
+            int64_t mtime;
+            uint32_t path;  // offset in the pool, relative to the root ("" for the root itself)
+            uint32_t reserved;
+        };
+
+        struct file_record
+        {
+            uint64_t hash;
+            uint32_t dir;   // index of the dir_record
+            uint32_t name;  // offset in the pool
+        };
+
+        // Used while scanning, and when the index has to be rebuilt after a refresh()
+        struct scanned_dir
+        {
+            ttlib::cstr path;
+            int64_t mtime;
+            std::vector<ttlib::cstr> files;
+        };
+
+        const index_header& header() const { return *reinterpret_cast<const index_header*>(m_buffer.data()); }
+        const dir_record* dirs() const { return reinterpret_cast<const dir_record*>(&header() + 1); }
+        const file_record* files() const { return reinterpret_cast<const file_record*>(dirs() + header().dir_count); }
+        const char* pool() const { return reinterpret_cast<const char*>(files() + header().file_count); }
+
+        tt::CASE hash_case() const { return (m_case == tt::CASE::exact) ? tt::CASE::exact : tt::CASE::either; }
+
+        // Returns false if the buffer isn't a valid index.
+        bool is_valid(size_t bytes) const;
+
+        // Adds rel_path and all of its subdirectories. Returns false if rel_path can't be read.
+        bool scan_tree(std::string_view rel_path, std::vector<scanned_dir>& dirs) const;
+
+        // Reads the files and subdirectories in a single directory. Returns false if it can't be read.
+        bool scan_dir(scanned_dir& dir, std::vector<ttlib::cstr>* subdirs) const;
+
+        ttlib::cstr full_path(std::string_view rel_path) const;
+
+        void build(std::vector<scanned_dir>& dirs);
+
+    private:
+        std::vector<uint64_t> m_buffer;  // uint64_t so that every record is aligned
+        ttlib::cstr m_root;
+        tt::CASE m_case;
+    };
+}  // namespace ttlib
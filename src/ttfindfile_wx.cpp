@@ -0,0 +1,289 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Parallel search of a directory tree for files by name or pattern
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>  // std::sort
+#include <deque>
+#include <filesystem>
+#include <system_error>  // std::error_code
+#include <thread>
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttfindfile_wx.h>
+
+using namespace ttlib;
+
+namespace
+{
+    template <tt::CASE C>
+    bool wildcard_match(std::string_view pattern, std::string_view name) noexcept
+    {
+        // When a '*' is followed by a mismatch, the '*' is extended by one more character and the
+        // rest of the pattern is tried again. Only the most recent '*' needs to be retried, so
+        // this never backtracks more than once per character of name.
+        size_t pat = 0;
+        size_t pos = 0;
+        size_t star = tt::npos;
+        size_t star_pos = 0;
+        while (pos < name.size())
+        {
+            if (pat < pattern.size() && pattern[pat] == '*')
+            {
+                star = pat++;
+                star_pos = pos;
+            }
+            else if (pat < pattern.size() &&
+                     (pattern[pat] == '?' || ttlib::fold_case<C>(pattern[pat]) == ttlib::fold_case<C>(name[pos])))
+            {
+                ++pat;
+                ++pos;
+            }
+            else if (star != tt::npos)
+            {
+                pat = star + 1;
+                pos = ++star_pos;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (pat < pattern.size() && pattern[pat] == '*')
+            ++pat;
+        return pat == pattern.size();
+    }
+}  // anonymous namespace
+
+bool ttlib::is_wildcard_match(std::string_view pattern, std::string_view name, tt::CASE checkcase)
+{
+    if (checkcase == tt::CASE::exact)
+        return wildcard_match<tt::CASE::exact>(pattern, name);
+    else
+        return wildcard_match<tt::CASE::either>(pattern, name);
+}
+
+// Each thread works from the back of its own list of directories, and takes directories from the
+// front of another thread's list when its own is empty. Directories at the front were found
+// first, so they tend to be near the top of the tree with more subdirectories below them.
+struct findfile::worker
+{
+    std::mutex mutex;
+    std::deque<ttlib::cstr> dirs;
+    std::vector<ttlib::cstr> matches;
+};
+
+findfile::findfile(tt::CASE checkcase) : m_names(checkcase), m_case(checkcase) {}
+
+void findfile::add_pattern(std::string_view pattern)
+{
+    // A pattern without wildcards is just a name, and names only need a hash lookup.
+    if (pattern.find_first_of("*?") == tt::npos)
+        m_names.insert(pattern);
+    else
+        m_patterns.emplace_back(pattern);
+}
+
+std::vector<ttlib::cstr> findfile::search(std::string_view dir)
+{
+    m_cancelled = false;
+    m_found = 0;
+
+    while (dir.size() > 1 && (dir.back() == '/' || dir.back() == '\\'))
+        dir.remove_suffix(1);
+    if (dir.empty())
+        return {};
+
+    auto count = m_threads ? m_threads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<worker> workers(count);
+    workers[0].dirs.emplace_back(dir);
+    m_pending = 1;
+    m_queued = 1;
+
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for (size_t index = 1; index < count; ++index)
+        threads.emplace_back(&findfile::run, this, std::ref(workers), index);
+    run(workers, 0);
+    for (auto& iter: threads)
+        iter.join();
+
+    std::vector<ttlib::cstr> results;
+    for (auto& iter: workers)
+        results.insert(results.end(), std::make_move_iterator(iter.matches.begin()),
+                       std::make_move_iterator(iter.matches.end()));
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+void findfile::run(std::vector<worker>& workers, size_t index)
+{
+    ttlib::cstr dir;
+    while (!m_cancelled)
+    {
+        if (next_dir(workers, index, dir))
+        {
+            read_dir(workers, index, dir);
+            if (--m_pending == 0)
+                wake_all();
+            continue;
+        }
+
+        // Another thread is still reading a directory that may add more work.
+        std::unique_lock<std::mutex> lock(m_wait_mutex);
+        m_wait.wait(lock, [this] { return m_queued > 0 || m_pending == 0 || m_cancelled; });
+        if (m_pending == 0)
+            break;
+    }
+}
+
+bool findfile::next_dir(std::vector<worker>& workers, size_t index, ttlib::cstr& dir)
+{
+    {
+        auto& self = workers[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (self.dirs.size())
+        {
+            dir = std::move(self.dirs.back());
+            self.dirs.pop_back();
+            --m_queued;
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < workers.size(); ++offset)
+    {
+        auto& other = workers[(index + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (other.dirs.size())
+        {
+            dir = std::move(other.dirs.front());
+            other.dirs.pop_front();
+            --m_queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+void findfile::read_dir(std::vector<worker>& workers, size_t index, const ttlib::cstr& dir)
+{
+    std::error_code ec;
+#if defined(_WIN32)
+    std::filesystem::directory_iterator iter(std::filesystem::path(dir.to_utf16()), ec);
+#else
+    std::filesystem::directory_iterator iter(std::filesystem::path(dir.c_str()), ec);
+#endif
+    if (ec)
+        return;
+
+    ttlib::cstr path(dir);
+    if (path.back() != '/' && path.back() != '\\')
+        path += '/';
+    const auto dir_len = path.size();
+
+    auto& self = workers[index];
+    std::vector<ttlib::cstr> subdirs;
+    for (; !ec && iter != std::filesystem::directory_iterator(); iter.increment(ec))
+    {
+        if (m_cancelled)
+            return;
+
+        path.resize(dir_len);
+#if defined(_WIN32)
+        ttlib::utf16to8(iter->path().filename().wstring(), path);
+#else
+        path += iter->path().filename().string();
+#endif
+        auto name = std::string_view(path).substr(dir_len);
+
+        // The type usually comes from the directory listing, so this rarely needs to call the
+        // file system.
+        std::error_code type_ec;
+        if (iter->is_directory(type_ec))
+        {
+            if (!iter->is_symlink(type_ec) && !is_pruned(name))
+                subdirs.emplace_back(path);
+        }
+        else if (is_match(name) && iter->is_regular_file(type_ec))
+        {
+            add_match(self, std::move(path));
+            path.assign(dir);
+            if (path.back() != '/' && path.back() != '\\')
+                path += '/';
+        }
+    }
+
+    if (subdirs.size())
+    {
+        m_pending += subdirs.size();
+        {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            for (auto& iter: subdirs)
+                self.dirs.emplace_back(std::move(iter));
+        }
+        m_queued += subdirs.size();
+        wake_all();
+    }
+}
+
+void findfile::wake_all()
+{
+    // Locking m_wait_mutex means a thread can't miss the notification between checking its
+    // condition and starting to wait.
+    {
+        std::lock_guard<std::mutex> lock(m_wait_mutex);
+    }
+    m_wait.notify_all();
+}
+
+void findfile::cancel()
+{
+    m_cancelled = true;
+    wake_all();
+}
+
+void findfile::add_match(worker& self, ttlib::cstr&& path)
+{
+    if (m_max_matches && m_found.fetch_add(1) >= m_max_matches)
+    {
+        cancel();
+        return;
+    }
+
+    if (m_callback)
+    {
+        std::lock_guard<std::mutex> lock(m_callback_mutex);
+        if (!m_cancelled && !m_callback(path))
+            cancel();
+    }
+    self.matches.emplace_back(std::move(path));
+
+    if (m_max_matches && m_found >= m_max_matches)
+        cancel();
+}
+
+bool findfile::is_match(std::string_view name) const
+{
+    if (m_names.contains(name))
+        return true;
+    for (auto& iter: m_patterns)
+    {
+        if (ttlib::is_wildcard_match(iter, name, m_case))
+            return true;
+    }
+    return false;
+}
+
+bool findfile::is_pruned(std::string_view name) const
+{
+    for (auto& iter: m_prune)
+    {
+        if (ttlib::is_wildcard_match(iter, name, m_case))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,130 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Parallel search of a directory tree for files by name or pattern
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttfindfile_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::findfile searches a directory and all of its subdirectories for any number of filenames
+/// and wildcard patterns at once. Each directory is read by one of several threads -- a thread
+/// that runs out of directories takes some from a thread that still has them, so large and small
+/// subtrees keep every thread busy.
+///
+///     ttlib::findfile finder;
+///     finder.add_name("CMakeLists.txt");
+///     finder.add_pattern("*.vcxproj");
+///     finder.add_prune(".git");
+///     for (auto& path: finder.search("src"))
+///         ...
+///
+/// Matches are returned as UTF-8 paths that start with the directory passed to search() and use
+/// '/' to separate directories. Only regular files (or symbolic links to them) are matched, and
+/// symbolic links to directories are not followed.
+
+#include <atomic>              // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <functional>          // std::function
+#include <mutex>               // std::mutex
+#include <string_view>
+#include <vector>
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+#include "ttcstr_wx.h"    // cstr -- std::string with additional methods
+#include "ttstrset_wx.h"  // strset -- Hashed set and map of strings with a case policy
+
+namespace ttlib
+{
+    /// Returns true if name matches pattern, where '*' matches any number of characters
+    /// (including none) and '?' matches any single character.
+    bool is_wildcard_match(std::string_view pattern, std::string_view name, tt::CASE checkcase = tt::CASE::exact);
+
+    class findfile
+    {
+    public:
+#if defined(_WIN32)
+        // Case-insensitive when compiled for Windows, otherwise case-sensitive
+        findfile(tt::CASE checkcase = tt::CASE::either);
+#else
+        // Case-insensitive when compiled for Windows, otherwise case-sensitive
+        findfile(tt::CASE checkcase = tt::CASE::exact);
+#endif
+
+        /// Adds a filename to search for. Names are looked up in a hash table, so adding a large
+        /// number of them doesn't slow down the search.
+        void add_name(std::string_view name) { m_names.insert(name); }
+
+        /// Adds a pattern ('*' and '?' wildcards) to search for. Every pattern is compared to
+        /// every file that doesn't match one of the names.
+        void add_pattern(std::string_view pattern);
+
+        /// Subdirectories whose name matches pattern ('*' and '?' wildcards) are not searched.
+        void add_prune(std::string_view pattern) { m_prune.emplace_back(pattern); }
+
+        /// Called for each match as soon as it is found. The callback is never called by more than
+        /// one thread at a time. Return false to cancel the search.
+        void set_callback(std::function<bool(std::string_view path)> callback) { m_callback = std::move(callback); }
+
+        /// Stops the search once count matches have been found. With more than one thread, which
+        /// matches are found first depends on the order the threads happen to read the directories
+        /// in. With one thread, the same matches are found every time the tree is searched.
+        void set_max_matches(size_t count) { m_max_matches = count; }
+
+        /// Number of threads to search with. Zero (the default) uses one thread for each core.
+        void set_threads(size_t count) { m_threads = count; }
+
+        /// Returns every matching file in dir and its subdirectories, sorted. If the search is
+        /// cancelled, only the matches found up to that point are returned. Directories that can't
+        /// be read are skipped.
+        std::vector<ttlib::cstr> search(std::string_view dir);
+
+        /// Stops a search that is in progress. This can be called from any thread.
+        void cancel();
+
+        bool is_cancelled() const noexcept { return m_cancelled; }
+
+    protected:
+        struct worker;
+
+        bool is_match(std::string_view name) const;
+        bool is_pruned(std::string_view name) const;
+
+        void run(std::vector<worker>& workers, size_t index);
+        void read_dir(std::vector<worker>& workers, size_t index, const ttlib::cstr& dir);
+        bool next_dir(std::vector<worker>& workers, size_t index, ttlib::cstr& dir);
+        void add_match(worker& self, ttlib::cstr&& path);
+
+        // Wakes any threads waiting for another thread to find more directories.
+        void wake_all();
+
+    private:
+        ttlib::strset m_names;
+        std::vector<ttlib::cstr> m_patterns;
+        std::vector<ttlib::cstr> m_prune;
+        std::function<bool(std::string_view path)> m_callback;
+
+        std::mutex m_callback_mutex;
+
+        // Threads with no directories to read wait on m_wait until a directory is queued, the
+        // search is finished, or it is cancelled.
+        std::mutex m_wait_mutex;
+        std::condition_variable m_wait;
+
+        std::atomic<size_t> m_pending { 0 };  // directories that have been found but not finished
+        std::atomic<size_t> m_queued { 0 };   // directories that are waiting to be read
+        std::atomic<size_t> m_found { 0 };
+        std::atomic<bool> m_cancelled { false };
+
+        size_t m_max_matches { 0 };  // 0 means no limit
+        size_t m_threads { 0 };
+        tt::CASE m_case;
+    };
+}  // namespace ttlib
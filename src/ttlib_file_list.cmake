@@ -7,4 +7,15 @@ set (ttlib_file_list
     ${CMAKE_CURRENT_LIST_DIR}/ttcvector_wx.cpp   # Vector class for storing ttlib::cstr strings
     ${CMAKE_CURRENT_LIST_DIR}/ttparser_wx.cpp    # Command line parser
     ${CMAKE_CURRENT_LIST_DIR}/ttstring_wx.cpp    # Enhanced version of wxString
+    ${CMAKE_CURRENT_LIST_DIR}/ttstrbuilder_wx.cpp  # Single-allocation string concatenation and string builder
+    ${CMAKE_CURRENT_LIST_DIR}/ttutf8_wx.cpp      # UTF-8 code point decoding, iteration, counting and indexing
+    ${CMAKE_CURRENT_LIST_DIR}/ttprefixset_wx.cpp  # Sorted set of strings optimized for prefix searches
+    ${CMAKE_CURRENT_LIST_DIR}/ttstringtable_wx.cpp  # Contiguous table of strings stored in a single buffer
+    ${CMAKE_CURRENT_LIST_DIR}/ttcsvreader_wx.cpp  # Streaming reader for CSV and TSV data
+    ${CMAKE_CURRENT_LIST_DIR}/ttstrset_wx.cpp  # Hashed set and map of strings with a case policy
+    ${CMAKE_CURRENT_LIST_DIR}/ttdiff_wx.cpp  # Line-based difference between two files or string vectors
+    ${CMAKE_CURRENT_LIST_DIR}/ttstatcache_wx.cpp  # Cache of file and directory existence checks
+    ${CMAKE_CURRENT_LIST_DIR}/ttfindfile_wx.cpp  # Parallel search of a directory tree for files by name or pattern
+    ${CMAKE_CURRENT_LIST_DIR}/ttdirindex_wx.cpp  # Persistent index of the filenames in a directory tree
+    ${CMAKE_CURRENT_LIST_DIR}/ttpath_wx.cpp  # Lexical path operations that don't access the file system
 )
@@ -7,11 +7,21 @@
 
 #include <cassert>
 #include <cctype>
-#include <locale>
+#include <cstring>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>  // _umul128, _BitScanForward
+#endif
 
 #include <ttlib_wx.h>
 
 #include <ttcstr_wx.h>
+#include <ttstatcache_wx.h>  // statcache -- Cache of file and directory existence checks
+#include <ttutf8_wx.h>
+
+#if defined(TTLIB_SSE2)
+    #include <emmintrin.h>
+#endif
 
 using namespace ttlib;
 using namespace tt;
@@ -19,6 +29,86 @@ using namespace tt;
 // Global empty string.
 const std::string ttlib::emptystring { std::string() };
 
+// clang-format off
+
+// S = space, D = digit, U = upper, L = lower
+#define S_ static_cast<unsigned char>(CHCLASS::space)
+#define D_ static_cast<unsigned char>(CHCLASS::digit)
+#define U_ static_cast<unsigned char>(CHCLASS::upper)
+#define L_ static_cast<unsigned char>(CHCLASS::lower)
+
+const unsigned char ttlib::char_class[256] = {
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  S_, S_, S_, S_, S_, 0,  0,   // 0x00
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   // 0x10
+    S_, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   // 0x20
+    D_, D_, D_, D_, D_, D_, D_, D_, D_, D_, 0,  0,  0,  0,  0,  0,   // 0x30
+    0,  U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_,  // 0x40
+    U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, 0,  0,  0,  0,  0,   // 0x50
+    0,  L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_,  // 0x60
+    L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, 0,  0,  0,  0,  0,   // 0x70
+    // 0x80 - 0xFF are all zero
+};
+
+#undef S_
+#undef D_
+#undef U_
+#undef L_
+
+// clang-format on
+
+namespace
+{
+    // Returns the index of the lowest set bit. mask must not be zero.
+    inline size_t lowest_bit(unsigned int mask) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+    }
+
+#if defined(TTLIB_SSE2)
+    // Returns a 16-bit mask with a bit set for each whitespace character in the 16 bytes at ptr.
+    inline unsigned int space_mask(const char* ptr) noexcept
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        __m128i is_space = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+
+        // \t, \n, \v, \f and \r are the contiguous range 0x09 - 0x0D
+        __m128i offset = _mm_sub_epi8(chunk, _mm_set1_epi8(0x09));
+        __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(0x04)), offset);
+
+        return static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(is_space, is_control)));
+    }
+#endif  // TTLIB_SSE2
+
+    // Returns the position of the first character where is_whitespace() == want_space, or tt::npos.
+    template <bool want_space>
+    size_t scan_space(std::string_view str) noexcept
+    {
+        size_t pos = 0;
+#if defined(TTLIB_SSE2)
+        for (; pos + 16 <= str.size(); pos += 16)
+        {
+            auto mask = space_mask(str.data() + pos);
+            if (!want_space)
+                mask = ~mask & 0xFFFF;
+            if (mask)
+                return pos + lowest_bit(mask);
+        }
+#endif  // TTLIB_SSE2
+        for (; pos < str.size(); ++pos)
+        {
+            if (ttlib::is_whitespace(str[pos]) == want_space)
+                return pos;
+        }
+        return tt::npos;
+    }
+}  // namespace
+
 const char* ttlib::next_utf8_char(const char* psz) noexcept
 {
     if (!psz)
@@ -33,40 +123,22 @@ const char* ttlib::next_utf8_char(const char* psz) noexcept
 
 std::string_view ttlib::find_space(std::string_view str) noexcept
 {
-    if (str.empty())
-        return {};
-    size_t pos;
-    for (pos = 0; pos < str.length(); ++pos)
-    {
-        if (ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
+    auto pos = scan_space<true>(str);
+    if (pos == tt::npos)
         return {};
     else
         return str.substr(pos);
 }
 
-size_t ttlib::find_space_pos(std::string_view str)
+size_t ttlib::find_space_pos(std::string_view str) noexcept
 {
-    auto view = ttlib::find_space(str);
-    if (view.empty())
-        return tt::npos;
-    else
-        return (str.size() - view.size());
+    return scan_space<true>(str);
 }
 
 std::string_view ttlib::find_nonspace(std::string_view str) noexcept
 {
-    if (str.empty())
-        return {};
-    size_t pos;
-    for (pos = 0; pos < str.length(); ++pos)
-    {
-        if (!ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
+    auto pos = scan_space<false>(str);
+    if (pos == tt::npos)
         return {};
     else
         return str.substr(pos);
@@ -74,33 +146,13 @@ std::string_view ttlib::find_nonspace(std::string_view str) noexcept
 
 size_t ttlib::find_nonspace_pos(std::string_view str) noexcept
 {
-    auto view = ttlib::find_nonspace(str);
-    if (view.empty())
-        return tt::npos;
-    else
-        return (str.size() - view.size());
+    return scan_space<false>(str);
 }
 
 std::string_view ttlib::stepover(std::string_view str) noexcept
 {
-    if (str.empty())
-        return {};
-
-    size_t pos;
-    for (pos = 0; pos < str.length(); ++pos)
-    {
-        if (ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
-        return {};
-
-    for (; pos < str.length(); ++pos)
-    {
-        if (!ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
+    auto pos = ttlib::stepover_pos(str);
+    if (pos == tt::npos)
         return {};
     else
         return str.substr(pos);
@@ -108,130 +160,228 @@ std::string_view ttlib::stepover(std::string_view str) noexcept
 
 size_t ttlib::stepover_pos(std::string_view str) noexcept
 {
-    auto view = ttlib::stepover(str);
-    if (view.empty())
+    auto pos = scan_space<true>(str);
+    if (pos == tt::npos)
         return tt::npos;
-    else
-        return (str.size() - view.size());
+
+    auto next = scan_space<false>(str.substr(pos));
+    if (next == tt::npos)
+        return tt::npos;
+    return pos + next;
 }
 
-bool ttlib::is_sameprefix(std::string_view strMain, std::string_view strSub, CASE checkcase)
+size_t ttlib::find_oneof_pos(std::string_view str, std::string_view set) noexcept
 {
-    if (strSub.empty())
-        return strMain.empty();
-
-    if (strMain.empty() || strMain.length() < strSub.length())
-        return false;
+    if (set.empty() || str.empty())
+        return tt::npos;
+    if (set.size() == 1)
+    {
+        auto found = static_cast<const char*>(std::memchr(str.data(), set[0], str.size()));
+        return found ? static_cast<size_t>(found - str.data()) : tt::npos;
+    }
 
-    if (checkcase == CASE::exact)
+    size_t pos = 0;
+#if defined(TTLIB_SSE2)
+    // Separator sets are normally only a few characters, so comparing each chunk against every
+    // character in the set is faster than a table lookup for each byte.
+    if (set.size() <= 16)
     {
-        auto iterMain = strMain.begin();
-        for (auto iterSub: strSub)
+        __m128i chars[16];
+        for (size_t idx = 0; idx < set.size(); ++idx)
+            chars[idx] = _mm_set1_epi8(set[idx]);
+
+        for (; pos + 16 <= str.size(); pos += 16)
         {
-            if (*iterMain++ != iterSub)
-                return false;
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + pos));
+            __m128i matches = _mm_cmpeq_epi8(chunk, chars[0]);
+            for (size_t idx = 1; idx < set.size(); ++idx)
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, chars[idx]));
+            if (auto mask = static_cast<unsigned int>(_mm_movemask_epi8(matches)); mask)
+                return pos + lowest_bit(mask);
         }
-        return true;
     }
-    else if (checkcase == CASE::either)
+#endif  // TTLIB_SSE2
+
+    uint64_t table[4] = {};
+    for (auto ch: set)
     {
-        auto iterMain = strMain.begin();
-        for (auto iterSub: strSub)
-        {
-            if (std::tolower(*iterMain++) != std::tolower(iterSub))
-                return false;
-        }
-        return true;
+        auto uch = static_cast<unsigned char>(ch);
+        table[uch >> 6] |= (1ull << (uch & 63));
     }
-    else if (checkcase == CASE::utf8)
+    for (; pos < str.size(); ++pos)
     {
-        auto utf8locale = std::locale("en_US.utf8");
-        auto iterMain = strMain.begin();
-        for (auto iterSub: strSub)
-        {
-            if (std::tolower(*iterMain++, utf8locale) != std::tolower(iterSub, utf8locale))
-                return false;
-        }
-        return true;
+        auto uch = static_cast<unsigned char>(str[pos]);
+        if (table[uch >> 6] & (1ull << (uch & 63)))
+            return pos;
     }
-    assert(!"Unknown CASE value");
-    return false;
+    return tt::npos;
 }
 
-std::string_view ttlib::find_str(std::string_view main, std::string_view sub, CASE checkcase)
+bool ttlib::is_sameprefix(std::string_view strMain, std::string_view strSub, CASE checkcase)
 {
-    if (sub.empty())
-        return {};
-
-    if (checkcase == CASE::exact)
-    {
-        auto pos = main.find(sub);
-        if (pos < main.length())
-            return main.substr(pos);
-
-        return {};
-    }
-
-    auto chLower = std::tolower(sub[0]);
+    return (checkcase == CASE::exact) ? ttlib::is_sameprefix<CASE::exact>(strMain, strSub) :
+                                        ttlib::is_sameprefix<CASE::either>(strMain, strSub);
+}
 
-    for (auto pos = 0U; pos < main.length(); ++pos)
-    {
-        if (std::tolower(main.at(pos)) == chLower)
-        {
-            size_t posSub;
-            for (posSub = 1; posSub < sub.length(); ++posSub)
-            {
-                if (pos + posSub >= main.length())
-                    return {};
-                if (std::tolower(main.at(pos + posSub)) != std::tolower(sub.at(posSub)))
-                    break;
-            }
-            if (posSub >= sub.length())
-                return main.substr(pos);
-        }
-    }
-    return {};
+std::string_view ttlib::find_str(std::string_view main, std::string_view sub, CASE checkcase)
+{
+    return (checkcase == CASE::exact) ? ttlib::find_str<CASE::exact>(main, sub) :
+                                        ttlib::find_str<CASE::either>(main, sub);
 }
 
 size_t ttlib::findstr_pos(std::string_view main, std::string_view sub, CASE checkcase)
 {
-    auto view = ttlib::find_str(main, sub, checkcase);
-    if (view.empty())
-        return tt::npos;
-    else
-        return (main.size() - view.size());
+    return (checkcase == CASE::exact) ? ttlib::findstr_pos<CASE::exact>(main, sub) :
+                                        ttlib::findstr_pos<CASE::either>(main, sub);
 }
 
 bool ttlib::contains(std::string_view main, std::string_view sub, CASE checkcase)
 {
-    return !ttlib::find_str(main, sub, checkcase).empty();
+    return (checkcase == CASE::exact) ? ttlib::contains<CASE::exact>(main, sub) :
+                                        ttlib::contains<CASE::either>(main, sub);
 }
 
 bool ttlib::is_sameas(std::string_view str1, std::string_view str2, CASE checkcase)
 {
-    if (str1.size() != str2.size())
-        return false;
+    return (checkcase == CASE::exact) ? ttlib::is_sameas<CASE::exact>(str1, str2) :
+                                        ttlib::is_sameas<CASE::either>(str1, str2);
+}
 
-    if (str1.empty())
-        return str2.empty();
+/////////////////////////////////////// get_hash ///////////////////////////////////////
 
-    if (checkcase == CASE::exact)
-        return (str1.compare(str2) == 0);
+// The hash is a variation of wyhash (public domain, see https://github.com/wangyi-fudan/wyhash). It reads the
+// string 8 bytes at a time and mixes each pair of words with a single 64x64->128 bit multiply.
+
+namespace
+{
+    constexpr uint64_t hash_secret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+                                          0x589965cc75374cc3ull };
 
-    auto main = str1.begin();
-    auto sub = str2.begin();
-    while (sub != str2.end())
+    inline void hash_mum(uint64_t& a, uint64_t& b) noexcept
     {
-        auto diff = std::tolower(main[0]) - std::tolower(sub[0]);
-        if (diff != 0)
-            return false;
-        ++main;
-        ++sub;
-        if (main == str1.end())
-            return (sub != str2.end() ? false : true);
+#if defined(__SIZEOF_INT128__)
+        __uint128_t result = a;
+        result *= b;
+        a = static_cast<uint64_t>(result);
+        b = static_cast<uint64_t>(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+        uint64_t carry = t < rl;
+        uint64_t lo = t + (rm1 << 32);
+        carry += lo < t;
+        uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+        a = lo;
+        b = hi;
+#endif
     }
 
-    return (main != str1.end() ? false : true);
+    inline uint64_t hash_mix(uint64_t a, uint64_t b) noexcept
+    {
+        hash_mum(a, b);
+        return a ^ b;
+    }
+
+    // Sets the 0x20 bit of every byte in the range 'A'-'Z' without branching. Bytes with the high bit set are
+    // left alone, matching std::tolower() in the "C" locale.
+    inline uint64_t hash_fold(uint64_t val) noexcept
+    {
+        uint64_t heptets = val & 0x7F7F7F7F7F7F7F7Full;
+        uint64_t above_Z = heptets + 0x2525252525252525ull;
+        uint64_t at_or_above_A = heptets + 0x3F3F3F3F3F3F3F3Full;
+        uint64_t is_upper = ~val & (at_or_above_A ^ above_Z) & 0x8080808080808080ull;
+        return val | (is_upper >> 2);
+    }
+
+    template <bool fold>
+    inline uint64_t hash_read8(const char* ptr) noexcept
+    {
+        uint64_t val;
+        std::memcpy(&val, ptr, sizeof(val));
+        return fold ? hash_fold(val) : val;
+    }
+
+    template <bool fold>
+    inline uint64_t hash_read4(const char* ptr) noexcept
+    {
+        uint32_t val;
+        std::memcpy(&val, ptr, sizeof(val));
+        return fold ? hash_fold(val) : val;
+    }
+
+    template <bool fold>
+    inline uint64_t hash_read3(const char* ptr, size_t len) noexcept
+    {
+        uint64_t val = (static_cast<uint64_t>(static_cast<uint8_t>(ptr[0])) << 16) |
+                       (static_cast<uint64_t>(static_cast<uint8_t>(ptr[len >> 1])) << 8) |
+                       static_cast<uint8_t>(ptr[len - 1]);
+        return fold ? hash_fold(val) : val;
+    }
+
+    template <bool fold>
+    uint64_t hash_bytes(const char* ptr, size_t len) noexcept
+    {
+        uint64_t seed = hash_mix(hash_secret[0], hash_secret[1]);
+        uint64_t a, b;
+        if (len <= 16)
+        {
+            if (len >= 4)
+            {
+                a = (hash_read4<fold>(ptr) << 32) | hash_read4<fold>(ptr + ((len >> 3) << 2));
+                b = (hash_read4<fold>(ptr + len - 4) << 32) | hash_read4<fold>(ptr + len - 4 - ((len >> 3) << 2));
+            }
+            else if (len > 0)
+            {
+                a = hash_read3<fold>(ptr, len);
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            size_t remaining = len;
+            if (remaining > 48)
+            {
+                uint64_t see1 = seed, see2 = seed;
+                do
+                {
+                    seed = hash_mix(hash_read8<fold>(ptr) ^ hash_secret[1], hash_read8<fold>(ptr + 8) ^ seed);
+                    see1 = hash_mix(hash_read8<fold>(ptr + 16) ^ hash_secret[2], hash_read8<fold>(ptr + 24) ^ see1);
+                    see2 = hash_mix(hash_read8<fold>(ptr + 32) ^ hash_secret[3], hash_read8<fold>(ptr + 40) ^ see2);
+                    ptr += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (remaining > 16)
+            {
+                seed = hash_mix(hash_read8<fold>(ptr) ^ hash_secret[1], hash_read8<fold>(ptr + 8) ^ seed);
+                ptr += 16;
+                remaining -= 16;
+            }
+            a = hash_read8<fold>(ptr + remaining - 16);
+            b = hash_read8<fold>(ptr + remaining - 8);
+        }
+
+        a ^= hash_secret[1];
+        b ^= seed;
+        hash_mum(a, b);
+        return hash_mix(a ^ hash_secret[0] ^ len, b ^ hash_secret[1]);
+    }
+}  // namespace
+
+uint64_t ttlib::get_hash(std::string_view str, CASE checkcase) noexcept
+{
+    // CASE::utf8 comparisons only change ASCII characters, so it folds the same way as CASE::either.
+    if (checkcase == CASE::exact)
+        return hash_bytes<false>(str.data(), str.size());
+    else
+        return hash_bytes<true>(str.data(), str.size());
 }
 
 int ttlib::atoi(std::string_view str) noexcept
@@ -369,46 +519,24 @@ bool ttlib::ChangeDir(std::string_view newdir)
     return false;
 }
 
+// Both functions use the ttlib::statcache installed with statcache::set_global() if there is one.
+
 bool ttlib::dir_exists(std::string_view dir)
 {
     if (dir.empty())
         return false;
-    try
-    {
-#if defined(_WIN32)
-        std::wstring str16;
-        ttlib::utf8to16(dir, str16);
-        auto path = std::filesystem::directory_entry(std::filesystem::path(str16));
-#else
-        auto path = std::filesystem::directory_entry(std::filesystem::path(dir));
-#endif
-        return (path.exists() && path.is_directory());
-    }
-    catch (const std::exception& /* e */)
-    {
-    }
-    return false;
+    if (auto* cache = ttlib::statcache::global(); cache)
+        return cache->dir_exists(dir);
+    return ttlib::statcache::query(dir) == tt::PATHTYPE::directory;
 }
 
 bool ttlib::file_exists(std::string_view filename)
 {
     if (filename.empty())
         return false;
-    try
-    {
-#if defined(_WIN32)
-        std::wstring str16;
-        ttlib::utf8to16(filename, str16);
-        auto path = std::filesystem::directory_entry(std::filesystem::path(str16));
-#else
-        auto path = std::filesystem::directory_entry(std::filesystem::path(filename));
-#endif
-        return (path.exists() && !path.is_directory());
-    }
-    catch (const std::exception& /* e */)
-    {
-    }
-    return false;
+    if (auto* cache = ttlib::statcache::global(); cache)
+        return cache->file_exists(filename);
+    return ttlib::statcache::query(filename) == tt::PATHTYPE::file;
 }
 
 ttlib::cstr ttlib::itoa(int value, bool format)
@@ -431,50 +559,208 @@ ttlib::cstr ttlib::itoa(size_t value, bool format)
     return str;
 }
 
-#define UINT8(ch)  static_cast<uint8_t>(ch)
-#define CHAR8(ch)  static_cast<char>(ch)
-#define CHAR16(ch) static_cast<char16_t>(ch)
+/////////////////////////////////// utf8to16 / utf16to8 ///////////////////////////////////
 
-std::string ttlib::utf16to8(std::wstring_view str)
-{
-    std::string str8;
-    ttlib::utf16to8(str, str8);
-    return str8;
-}
+// Both directions make two passes over the source: the first calculates the exact number of
+// output characters so that dest is resized only once, the second fills it in. Runs of ASCII are
+// handled 16 characters at a time when SSE2 is available. Invalid sequences are replaced with
+// U+FFFD and cause the function to return false.
 
-void ttlib::utf16to8(std::wstring_view str, std::string& dest)
+namespace
 {
-    for (size_t pos = 0; pos < str.size(); ++pos)
+    // Returns the code point starting at str[pos] and advances pos past it. Lone surrogates and
+    // values beyond U+10FFFF (possible when wchar_t is 32 bits) are returned as U+FFFD.
+    inline char32_t decode_utf16(std::wstring_view str, size_t& pos, bool& valid) noexcept
+    {
+        auto val = static_cast<uint32_t>(str[pos++]);
+        if (val < 0xD800 || (val > 0xDFFF && val <= 0x10FFFF))
+            return val;
+
+        if (val <= 0xDBFF && pos < str.size())
+        {
+            auto low = static_cast<uint32_t>(str[pos]);
+            if (low >= 0xDC00 && low <= 0xDFFF)
+            {
+                ++pos;
+                return 0x10000 + ((val - 0xD800) << 10) + (low - 0xDC00);
+            }
+        }
+        valid = false;
+        return replacement_char;
+    }
+
+    // Returns the number of leading characters in the 16 bytes at ptr that are ASCII.
+    inline size_t ascii_run16(const char* ptr) noexcept
+    {
+#if defined(TTLIB_SSE2)
+        auto mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr))));
+        return mask ? lowest_bit(mask) : 16;
+#else
+        size_t pos = 0;
+        while (pos < 16 && static_cast<unsigned char>(ptr[pos]) < 0x80)
+            ++pos;
+        return pos;
+#endif  // TTLIB_SSE2
+    }
+
+    // Returns true if all 16 wide characters at ptr are ASCII.
+    inline bool is_ascii_wide16(const wchar_t* ptr) noexcept
     {
-        uint32_t val = (str[pos] & 0xFFFF);
-        if (val >= 0xD800 && val <= 0xDBFF)
+#if defined(TTLIB_SSE2)
+        constexpr size_t per_reg = 16 / sizeof(wchar_t);
+        auto src = reinterpret_cast<const __m128i*>(ptr);
+        __m128i combined = _mm_loadu_si128(src);
+        for (size_t idx = 1; idx < 16 / per_reg; ++idx)
+            combined = _mm_or_si128(combined, _mm_loadu_si128(src + idx));
+        if constexpr (sizeof(wchar_t) == 2)
+            combined = _mm_and_si128(combined, _mm_set1_epi16(static_cast<short>(0xFF80)));
+        else
+            combined = _mm_and_si128(combined, _mm_set1_epi32(static_cast<int>(0xFFFFFF80)));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(combined, _mm_setzero_si128())) == 0xFFFF;
+#else
+        for (size_t pos = 0; pos < 16; ++pos)
         {
-            val = (val << 10) + (str[++pos] & 0xFFFF) + 0xFCA02400;
+            if (static_cast<uint32_t>(ptr[pos]) >= 0x80)
+                return false;
         }
+        return true;
+#endif  // TTLIB_SSE2
+    }
 
-        if (val < 0x80)
+    // Widens 16 ASCII characters at src into dst.
+    inline void widen_ascii16(const char* src, wchar_t* dst) noexcept
+    {
+#if defined(TTLIB_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        auto out = reinterpret_cast<__m128i*>(dst);
+        if constexpr (sizeof(wchar_t) == 2)
         {
-            dest.push_back(CHAR8(val));
+            _mm_storeu_si128(out, lo);
+            _mm_storeu_si128(out + 1, hi);
         }
-        else if (val < 0x800)
+        else
         {
-            dest.push_back(CHAR8((val >> 6) | 0xC0));
-            dest.push_back(CHAR8((val & 0x3f) | 0x80));
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
         }
-        else if (val < 0x10000)
+#else
+        for (size_t pos = 0; pos < 16; ++pos)
+            dst[pos] = static_cast<wchar_t>(static_cast<unsigned char>(src[pos]));
+#endif  // TTLIB_SSE2
+    }
+
+    // Narrows 16 ASCII wide characters at src into dst.
+    inline void narrow_ascii16(const wchar_t* src, char* dst) noexcept
+    {
+#if defined(TTLIB_SSE2)
+        auto in = reinterpret_cast<const __m128i*>(src);
+        __m128i packed;
+        if constexpr (sizeof(wchar_t) == 2)
         {
-            dest.push_back(CHAR8((val >> 12) | 0xE0));
-            dest.push_back(CHAR8(((val >> 6) & 0x3F) | 0x80));
-            dest.push_back(CHAR8((val & 0x3f) | 0x80));
+            packed = _mm_packus_epi16(_mm_loadu_si128(in), _mm_loadu_si128(in + 1));
         }
         else
         {
-            dest.push_back(CHAR8((val >> 18) | 0xF0));
-            dest.push_back(CHAR8(((val >> 12) & 0x3F) | 0x80));
-            dest.push_back(CHAR8(((val >> 6) & 0x3F) | 0x80));
-            dest.push_back(CHAR8((val & 0x3f) | 0x80));
+            __m128i lo = _mm_packs_epi32(_mm_loadu_si128(in), _mm_loadu_si128(in + 1));
+            __m128i hi = _mm_packs_epi32(_mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3));
+            packed = _mm_packus_epi16(lo, hi);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), packed);
+#else
+        for (size_t pos = 0; pos < 16; ++pos)
+            dst[pos] = static_cast<char>(src[pos]);
+#endif  // TTLIB_SSE2
+    }
+}  // anonymous namespace
+
+size_t ttlib::validate_utf8(std::string_view str) noexcept
+{
+    auto src = reinterpret_cast<const unsigned char*>(str.data());
+    const size_t length = str.size();
+    size_t pos = 0;
+
+    while (pos < length)
+    {
+#if defined(TTLIB_SSE2)
+        // Skip over ASCII 64 bytes at a time, then 16 bytes at a time.
+        while (pos + 64 <= length)
+        {
+            auto block = reinterpret_cast<const __m128i*>(src + pos);
+            __m128i combined = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(block), _mm_loadu_si128(block + 1)),
+                                            _mm_or_si128(_mm_loadu_si128(block + 2), _mm_loadu_si128(block + 3)));
+            if (_mm_movemask_epi8(combined))
+                break;
+            pos += 64;
+        }
+#endif  // TTLIB_SSE2
+        if (pos + 16 <= length)
+        {
+            auto run = ascii_run16(str.data() + pos);
+            pos += run;
+            if (run == 16)
+                continue;
         }
+        else if (src[pos] < 0x80)
+        {
+            ++pos;
+            continue;
+        }
+
+        bool valid = true;
+        char32_t codepoint;
+        auto consumed = decode_utf8(str.data() + pos, length - pos, codepoint, valid);
+        if (!valid)
+            return pos;
+        pos += consumed;
     }
+    return tt::npos;
+}
+
+std::string ttlib::utf16to8(std::wstring_view str)
+{
+    std::string str8;
+    ttlib::utf16to8(str, str8);
+    return str8;
+}
+
+bool ttlib::utf16to8(std::wstring_view str, std::string& dest)
+{
+    bool valid = true;
+
+    size_t count = 0;
+    for (size_t pos = 0; pos < str.size();)
+    {
+        if (pos + 16 <= str.size() && is_ascii_wide16(str.data() + pos))
+        {
+            pos += 16;
+            count += 16;
+            continue;
+        }
+        count += utf8_size(decode_utf16(str, pos, valid));
+    }
+
+    auto original = dest.size();
+    dest.resize(original + count);
+    char* dst = dest.data() + original;
+
+    for (size_t pos = 0; pos < str.size();)
+    {
+        if (pos + 16 <= str.size() && is_ascii_wide16(str.data() + pos))
+        {
+            narrow_ascii16(str.data() + pos, dst);
+            pos += 16;
+            dst += 16;
+            continue;
+        }
+        dst = encode_utf8(decode_utf16(str, pos, valid), dst);
+    }
+    return valid;
 }
 
 std::wstring ttlib::utf8to16(std::string_view str)
@@ -484,60 +770,62 @@ std::wstring ttlib::utf8to16(std::string_view str)
     return str16;
 }
 
-void ttlib::utf8to16(std::string_view str, std::wstring& dest)
+// Note that the output is always UTF-16, even on platforms where wchar_t is 32 bits.
+
+bool ttlib::utf8to16(std::string_view str, std::wstring& dest)
 {
-    for (size_t pos = 0; pos < str.length(); ++pos)
+    bool valid = true;
+    auto src = reinterpret_cast<const unsigned char*>(str.data());
+    const size_t length = str.size();
+
+    size_t count = 0;
+    for (size_t pos = 0; pos < length;)
     {
-        if (UINT8(str[pos]) < 0x80)
-            dest.push_back(CHAR16(str[pos]));
-        else
+        if (pos + 16 <= length)
         {
-            uint32_t val = (str[pos] & 0xFF);
-            if ((UINT8(str[pos]) >> 5) == 6)
-            {
-                assertm(pos + 1 < str.size(), "Invalid UTF8 string");
-                if (pos + 1 < str.size())
-                {
-                    val = ((val << 6) & 0x7FF) + (str[++pos] & 0x3F);
-                }
-            }
-
-            else if ((UINT8(str[pos]) >> 4) == 14)
-            {
-                assertm(pos + 2 < str.size(), "Invalid UTF8 string");
-                if (pos + 2 < str.size())
-                {
-                    val = ((val << 12) & 0xFFFF) + ((str[++pos] << 6) & 0xFFF);
-                    val += (str[++pos] & 0x3F);
-                }
-            }
+            auto run = ascii_run16(str.data() + pos);
+            pos += run;
+            count += run;
+            if (run == 16)
+                continue;
+        }
+        if (src[pos] < 0x80)
+        {
+            ++pos;
+            ++count;
+            continue;
+        }
+        char32_t codepoint;
+        pos += decode_utf8(str.data() + pos, length - pos, codepoint, valid);
+        count += (codepoint > 0xFFFF ? 2 : 1);
+    }
 
-            else if ((UINT8(str[pos]) >> 3) == 30)
-            {
-                assertm(pos + 3 < str.size(), "Invalid UTF8 string");
-                if (pos + 3 < str.size())
-                {
-                    val = ((val << 18) & 0x1FFFFF) + ((str[++pos] << 12) & 0x3FFFF);
-                    val += (str[++pos] << 6) & 0xFFF;
-                    val += (str[++pos] & 0x3F);
-                }
-            }
-            else
-            {
-                assertm(str[pos], "Invalid UTF8 string");
-            }
+    auto original = dest.size();
+    dest.resize(original + count);
+    wchar_t* dst = dest.data() + original;
 
-            if (val > 0xFFFF)
-            {
-                dest.push_back(CHAR16((val >> 10) + 0xD7C0));
-                dest.push_back(CHAR16((val & 0x3FF) + 0xDC00));
-            }
-            else
-            {
-                dest.push_back(CHAR16(val));
-            }
+    for (size_t pos = 0; pos < length;)
+    {
+        if (pos + 16 <= length && ascii_run16(str.data() + pos) == 16)
+        {
+            widen_ascii16(str.data() + pos, dst);
+            pos += 16;
+            dst += 16;
+            continue;
+        }
+        char32_t codepoint;
+        pos += decode_utf8(str.data() + pos, length - pos, codepoint, valid);
+        if (codepoint > 0xFFFF)
+        {
+            *dst++ = static_cast<wchar_t>(0xD800 + ((codepoint - 0x10000) >> 10));
+            *dst++ = static_cast<wchar_t>(0xDC00 + ((codepoint - 0x10000) & 0x3FF));
+        }
+        else
+        {
+            *dst++ = static_cast<wchar_t>(codepoint);
         }
     }
+    return valid;
 }
 
 #if (defined(_WIN32) && defined(_WX_DEFS_H_))
@@ -560,6 +848,8 @@ HINSTANCE ttlib::ShellRun_wx(const wxString& filename, const wxString& args, con
 
 #include <wx/msgdlg.h>
 
+#include <ttstrbuilder_wx.h>  // Single-allocation string concatenation and string builder
+
 static std::mutex g_mutexAssert;
 
 bool ttlib::AssertDialog(const char* filename, const char* function, int line, const char* cond, const std::string& msg)
@@ -567,17 +857,9 @@ bool ttlib::AssertDialog(const char* filename, const char* function, int line, c
     // This is in case additional message processing results in an assert while this one is already being displayed.
     std::unique_lock<std::mutex> classLock(g_mutexAssert);
 
-    ttlib::cstr str;
-
-    if (cond)
-        str << "Expression: " << cond << "\n\n";
-    if (!msg.empty())
-        str << "Comment: " << msg << "\n\n";
-
-    str << "File: " << filename << "\n";
-    str << "Function: " << function << "\n";
-    str << "Line: " << line << "\n\n";
-    str << "Press Yes to call wxTrap, No to continue, Cancel to exit program.";
+    auto str = ttlib::concat(cond ? "Expression: " : "", cond, cond ? "\n\n" : "", msg.empty() ? "" : "Comment: ", msg,
+                             msg.empty() ? "" : "\n\n", "File: ", filename, "\nFunction: ", function, "\nLine: ", line,
+                             "\n\nPress Yes to call wxTrap, No to continue, Cancel to exit program.");
 
     wxMessageDialog dlg(nullptr, str.wx_str(), "Assertion!", wxCENTRE | wxYES_NO | wxCANCEL);
     dlg.SetYesNoCancelLabels("wxTrap", "Continue", "Exit program");
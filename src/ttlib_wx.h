@@ -22,6 +22,7 @@
 #endif
 
 #include <cctype>
+#include <cstdint>
 #include <filesystem>  // directory_entry
 #include <stdlib.h>    // for std::abs(long)
 #include <string>
@@ -32,6 +33,12 @@
     #define assertm(exp, msg) assert(((void) msg, exp))
 #endif
 
+// Defined when SSE2 intrinsics are available without any additional compiler flags. Functions that scan
+// strings use this to process 16 characters at a time.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TTLIB_SSE2
+#endif
+
 // The tt namespace is for enums and constexpr values that only require a header. The ttlib namespace is for
 // functions and classes that require linking to ttLib_wx.lib in order to use.
 
@@ -61,6 +68,15 @@ namespace tt
         all = true,
     };
 
+    // Bits used in the ttlib::char_class table. Use ttlib::is_char_class() to test them.
+    enum class CHCLASS : unsigned char
+    {
+        space = 1 << 0,  // ' ', \t, \n, \v, \f, \r
+        digit = 1 << 1,  // '0' - '9'
+        upper = 1 << 2,  // 'A' - 'Z'
+        lower = 1 << 3,  // 'a' - 'z'
+    };
+
 }  // namespace tt
 
 namespace ttlib
@@ -69,20 +85,30 @@ namespace ttlib
 
     extern const std::string emptystring;
 
+    // Classifies every possible char value using tt::CHCLASS bits. Only ASCII characters are
+    // classified, so unlike the std:: functions, the result never depends on the current locale.
+    extern const unsigned char char_class[256];
+
+    // Returns true if ch has the tt::CHCLASS bit in the ttlib::char_class table.
+    inline bool is_char_class(char ch, tt::CHCLASS bit)
+    {
+        return (char_class[static_cast<unsigned char>(ch)] & static_cast<unsigned char>(bit));
+    }
+
     // These functions are provided for convenience since they cast a char to unsigned char before calling the std::
-    // library function.
+    // library function. is_digit() and is_whitespace() use the ttlib::char_class table instead.
 
     inline bool is_alnum(char ch) { return std::isalnum(static_cast<unsigned char>(ch)); }
     inline bool is_alpha(char ch) { return std::isalpha(static_cast<unsigned char>(ch)); }
     inline bool is_blank(char ch) { return std::isblank(static_cast<unsigned char>(ch)); }
     inline bool is_cntrl(char ch) { return std::iscntrl(static_cast<unsigned char>(ch)); }
-    inline bool is_digit(char ch) { return std::isdigit(static_cast<unsigned char>(ch)); }
+    inline bool is_digit(char ch) { return is_char_class(ch, tt::CHCLASS::digit); }
     inline bool is_graph(char ch) { return std::isgraph(static_cast<unsigned char>(ch)); }
     inline bool is_lower(char ch) { return std::islower(static_cast<unsigned char>(ch)); }
     inline bool is_print(char ch) { return std::isprint(static_cast<unsigned char>(ch)); }
     inline bool is_punctuation(char ch) { return std::ispunct(static_cast<unsigned char>(ch)); }
     inline bool is_upper(char ch) { return std::isupper(static_cast<unsigned char>(ch)); }
-    inline bool is_whitespace(char ch) { return std::isspace(static_cast<unsigned char>(ch)); }
+    inline bool is_whitespace(char ch) { return is_char_class(ch, tt::CHCLASS::space); }
 
     // Is ch the start of a utf8 sequence?
     constexpr inline bool is_utf8(char ch) noexcept { return ((ch & 0xC0) != 0x80); }
@@ -113,6 +139,105 @@ namespace ttlib
     // Same as find_str but with a boolean return instead of a string_view.
     bool contains(std::string_view main, std::string_view sub, tt::CASE checkcase = tt::CASE::exact);
 
+    // The following templates are compile-time versions of the functions above, e.g.
+    // ttlib::is_sameas<tt::CASE::either>(str1, str2). Because the comparison is chosen when the
+    // template is instantiated, the loops contain no checks of checkcase and can be vectorized. The
+    // functions above call these.
+    //
+    // CASE::either and CASE::utf8 both fold ASCII letters only, since a multi-byte UTF-8 character
+    // cannot be folded one byte at a time. This is the same folding that get_hash() uses.
+
+    template <tt::CASE checkcase>
+    constexpr char fold_case(char ch) noexcept
+    {
+        if constexpr (checkcase == tt::CASE::exact)
+            return ch;
+        else
+            return static_cast<char>(ch + ((static_cast<unsigned char>(ch - 'A') < 26) << 5));
+    }
+
+    template <tt::CASE checkcase>
+    bool is_sameas(std::string_view str1, std::string_view str2) noexcept
+    {
+        if (str1.size() != str2.size())
+            return false;
+
+        if constexpr (checkcase == tt::CASE::exact)
+        {
+            return str1.compare(str2) == 0;
+        }
+        else
+        {
+            // The inner loop has no early exit so that it can be vectorized.
+            size_t pos = 0;
+            for (; pos + 16 <= str1.size(); pos += 16)
+            {
+                unsigned char diff = 0;
+                for (size_t idx = pos; idx < pos + 16; ++idx)
+                {
+                    diff |=
+                        static_cast<unsigned char>(fold_case<checkcase>(str1[idx]) ^ fold_case<checkcase>(str2[idx]));
+                }
+                if (diff)
+                    return false;
+            }
+            for (; pos < str1.size(); ++pos)
+            {
+                if (fold_case<checkcase>(str1[pos]) != fold_case<checkcase>(str2[pos]))
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    template <tt::CASE checkcase>
+    bool is_sameprefix(std::string_view strMain, std::string_view strSub) noexcept
+    {
+        if (strSub.empty())
+            return strMain.empty();
+        if (strMain.size() < strSub.size())
+            return false;
+        return ttlib::is_sameas<checkcase>(strMain.substr(0, strSub.size()), strSub);
+    }
+
+    template <tt::CASE checkcase>
+    size_t findstr_pos(std::string_view main, std::string_view sub) noexcept
+    {
+        if (sub.empty() || sub.size() > main.size())
+            return tt::npos;
+
+        if constexpr (checkcase == tt::CASE::exact)
+        {
+            return main.find(sub);
+        }
+        else
+        {
+            auto first = fold_case<checkcase>(sub[0]);
+            auto rest = sub.substr(1);
+            auto last = main.size() - sub.size();
+            for (size_t pos = 0; pos <= last; ++pos)
+            {
+                if (fold_case<checkcase>(main[pos]) == first &&
+                    ttlib::is_sameas<checkcase>(main.substr(pos + 1, rest.size()), rest))
+                    return pos;
+            }
+            return tt::npos;
+        }
+    }
+
+    template <tt::CASE checkcase>
+    std::string_view find_str(std::string_view main, std::string_view sub) noexcept
+    {
+        auto pos = ttlib::findstr_pos<checkcase>(main, sub);
+        return (pos == tt::npos) ? std::string_view() : main.substr(pos);
+    }
+
+    template <tt::CASE checkcase>
+    bool contains(std::string_view main, std::string_view sub) noexcept
+    {
+        return ttlib::findstr_pos<checkcase>(main, sub) != tt::npos;
+    }
+
     template <class iterT>
     // Returns true if any string in the iteration list appears somewhere in the the main string.
     bool strContains(std::string_view str, iterT iter, tt::CASE checkcase = tt::CASE::exact)
@@ -126,7 +251,8 @@ namespace ttlib
     }
 
     // Combining has_member() and add_if() lets you use a std::vector like a std::set -- the vector will have have a lower
-    // memory footprint, but searching will be slower.
+    // memory footprint, but searching will be slower. If the vector will hold a large number of strings, use
+    // ttlib::strset (ttstrset_wx.h) instead -- these functions have overloads for it.
 
     template <class T>
     bool has_member(const std::vector<T>& vec, std::string_view str, tt::CASE checkcase = tt::CASE::exact)
@@ -203,15 +329,65 @@ namespace ttlib
         return tt::npos;
     }
 
+    // Generates a 64-bit hash of the string using a wyhash-style algorithm that processes 8
+    // bytes at a time.
+    //
+    // If checkcase is CASE::either or CASE::utf8, ASCII letters are folded to lowercase before
+    // hashing so that any two strings is_sameas() considers identical will hash the same.
+    uint64_t get_hash(std::string_view str, tt::CASE checkcase = tt::CASE::exact) noexcept;
+
+    // The following functors can be used as the Hash and KeyEqual parameters of std::unordered_map and
+    // std::unordered_set when the key is a std::string, ttlib::cstr or ttlib::sview. They are transparent, so
+    // when compiled with C++20 find(), count() and contains() accept a std::string_view without constructing a
+    // temporary key string.
+    //
+    // str_hashi and str_equali ignore ASCII case and must be used together. ttlib::strindex (ttstrindex_wx.h), the
+    // index behind ttlib::strset and ttlib::strmap, is built on them.
+
+    struct str_hash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const noexcept { return static_cast<size_t>(ttlib::get_hash(str)); }
+    };
+
+    struct str_hashi
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const noexcept
+        {
+            return static_cast<size_t>(ttlib::get_hash(str, tt::CASE::either));
+        }
+    };
+
+    struct str_equal
+    {
+        using is_transparent = void;
+        bool operator()(std::string_view str1, std::string_view str2) const noexcept { return str1 == str2; }
+    };
+
+    struct str_equali
+    {
+        using is_transparent = void;
+        bool operator()(std::string_view str1, std::string_view str2) const
+        {
+            return ttlib::is_sameas(str1, str2, tt::CASE::either);
+        }
+    };
+
     // Returns a pointer to the next character in a UTF8 string.
     const char* next_utf8_char(const char* psz) noexcept;
 
+    /// Returns tt::npos if str is well-formed UTF-8, otherwise returns the offset of the first
+    /// byte of the first invalid sequence. Overlong forms, surrogates, truncated sequences and
+    /// values above U+10FFFF are all considered invalid.
+    size_t validate_utf8(std::string_view str) noexcept;
+
     // Returns view to the next whitespace character. View is empty if there are no more
     // whitespaces.
     std::string_view find_space(std::string_view str) noexcept;
 
     // Returns position of next whitespace character or npos if not found.
-    size_t find_space_pos(std::string_view str);
+    size_t find_space_pos(std::string_view str) noexcept;
 
     // Returns view to the next non-whitespace character. View is empty if there are no
     // non-whitespace characters.
@@ -226,6 +402,10 @@ namespace ttlib
     // Equivalent to find_nonspace(find_space(str)) returning the position or npos.
     size_t stepover_pos(std::string_view str) noexcept;
 
+    // Returns position of the first character in str that matches any character in set, or npos
+    // if not found. Unlike strpbrk(), neither str nor set needs to be zero-terminated.
+    size_t find_oneof_pos(std::string_view str, std::string_view set) noexcept;
+
     // Converts a string into an integer.
     //
     // If string begins with '0x' it is assumed to be hexadecimal and is converted.
@@ -269,11 +449,18 @@ namespace ttlib
     // if the directory is valid but could not be changed to.
     bool ChangeDir(std::string_view newdir);
 
+    // These use the cache installed with ttlib::statcache::set_global() (ttstatcache_wx.h) if
+    // there is one.
     bool dir_exists(std::string_view dir);
     bool file_exists(std::string_view filename);
 
-    void utf8to16(std::string_view str, std::wstring& dest);
-    void utf16to8(std::wstring_view str, std::string& dest);
+    /// Appends the UTF-16 conversion of str to dest. Invalid sequences are converted to U+FFFD.
+    /// Returns false if any invalid sequences were found.
+    bool utf8to16(std::string_view str, std::wstring& dest);
+
+    /// Appends the UTF-8 conversion of str to dest. Unpaired surrogates are converted to U+FFFD.
+    /// Returns false if any unpaired surrogates were found.
+    bool utf16to8(std::wstring_view str, std::string& dest);
 
     std::wstring utf8to16(std::string_view str);
     std::string utf16to8(std::wstring_view str);
@@ -11,132 +11,103 @@
 
 using namespace ttlib;
 
-void multistr::SetString(std::string_view str, char separator, tt::TRIM trim)
-{
-    clear();
-    size_t start = 0;
-    size_t end = str.find_first_of(separator);
+/////////////////////////////////////// split ///////////////////////////////////////
 
-    // The last string will not have a separator, so end == tt::npos, but we still need to add that final string
-    for (;;)
+void split::init()
+{
+    // A separator such as "aa" can overlap itself, in which case searching backwards could find
+    // different separators than searching forwards does.
+    for (size_t len = 1; !m_oneof && len < m_sep.size(); ++len)
     {
-        emplace_back();
-        if (trim == tt::TRIM::both || trim == tt::TRIM::left)
+        if (m_sep.substr(0, len) == m_sep.substr(m_sep.size() - len))
         {
-            auto begin = str.find_first_not_of(" \t\n\r\f\v", start);
-            if (begin != tt::npos)
-            {
-                start = begin;
-            }
-            else
-            {
-                if (end != tt::npos)
-                {
-                    start = end;
-                }
-                else
-                {
-                    // We're at the end, there's nothing here but whitespace, so we're done
-                    break;
-                }
-            }
+            m_overlaps = true;
+            break;
         }
+    }
 
-        if (trim == tt::TRIM::both || trim == tt::TRIM::right)
-        {
-            auto temp_end = end;
-            if (end == tt::npos)
-                temp_end = str.length();
-            while (temp_end > start && ttlib::is_whitespace(str.at(temp_end - 1)))
-            {
-                --temp_end;
-            }
-            back().assign(str.substr(start, temp_end - start));
-        }
+    // A separator at the very end of the string does not start another substring.
+    m_limit = m_str.size();
+    if (!m_sep_len || m_limit < m_sep_len || !is_sep(m_limit - m_sep_len))
+        return;
 
-        else if (end == tt::npos)
-        {
-            back().assign(str.substr(start, str.length() - start));
-        }
-        else
-        {
-            back().assign(str.substr(start, end - start));
-        }
+    if (!m_overlaps)
+    {
+        m_limit -= m_sep_len;
+        return;
+    }
 
-        // The last string will not have a separator after it so end will already be set to tt::npos
-        if (end == tt::npos)
-            break;
+    // Only remove the final separator if it is one that searching forwards would find.
+    size_t last = tt::npos;
+    for (auto pos = find_sep(0); pos < m_limit; pos = find_sep(pos + m_sep_len))
+        last = pos;
+    if (last == m_limit - m_sep_len)
+        m_limit = last;
+}
 
-        start = end + sizeof(char);
-        if (start >= str.length())
-            break;
+void split::prev(size_t& begin, size_t& end) const
+{
+    end = (begin == tt::npos) ? m_limit : begin - m_sep_len;
+    if (!m_sep_len)
+    {
+        begin = 0;
+        return;
+    }
 
-        end = str.find_first_of(separator, start);
+    if (m_overlaps)
+    {
+        // Walk forward from the start so that the separators match the ones next() finds.
+        begin = 0;
+        for (auto pos = find_sep(0); pos < end; pos = find_sep(begin))
+            begin = pos + m_sep_len;
+        return;
     }
+
+    auto head = m_str.substr(0, end);
+    size_t pos;
+    if (m_oneof)
+        pos = head.find_last_of(m_sep);
+    else
+        pos = m_sep.empty() ? head.rfind(m_sep_char) : head.rfind(m_sep);
+    begin = (pos == tt::npos) ? 0 : pos + m_sep_len;
 }
 
-void multistr::SetString(std::string_view str, std::string_view separator, tt::TRIM trim)
+ttlib::sview split::trimmed(size_t begin, size_t end) const
 {
-    clear();
-    size_t start = 0;
-    size_t end = str.find_first_of(separator);
-
-    // The last string will not have a separator, so end == tt::npos, but we still need to add that final string
-    for (;;)
+    if (m_trim == tt::TRIM::both || m_trim == tt::TRIM::left)
     {
-        emplace_back();
-        if (trim == tt::TRIM::both || trim == tt::TRIM::left)
-        {
-            auto begin = str.find_first_not_of(" \t\n\r\f\v", start);
-            if (begin != tt::npos)
-            {
-                start = begin;
-            }
-            else
-            {
-                if (end != tt::npos)
-                {
-                    start = end;
-                }
-                else
-                {
-                    // We're at the end, there's nothing here but whitespace, so we're done
-                    break;
-                }
-            }
-        }
-
-        if (trim == tt::TRIM::both || trim == tt::TRIM::right)
-        {
-            auto temp_end = end;
-            if (end == tt::npos)
-                temp_end = str.length();
-            while (temp_end > start && ttlib::is_whitespace(str.at(temp_end - 1)))
-            {
-                --temp_end;
-            }
-            back().assign(str.substr(start, temp_end - start));
-        }
+        while (begin < end && ttlib::is_whitespace(m_str[begin]))
+            ++begin;
+    }
+    if (m_trim == tt::TRIM::both || m_trim == tt::TRIM::right)
+    {
+        while (end > begin && ttlib::is_whitespace(m_str[end - 1]))
+            --end;
+    }
+    return ttlib::sview(m_str.data() + begin, end - begin);
+}
 
-        else if (end == tt::npos)
-        {
-            back().assign(str.substr(start, str.length() - start));
-        }
-        else
-        {
-            back().assign(str.substr(start, end - start));
-        }
+/////////////////////////////////////// multistr ///////////////////////////////////////
 
-        // The last string will not have a separator after it so end will already be set to tt::npos
-        if (end == tt::npos)
-            break;
+void multistr::SetString(std::string_view str, char separator, tt::TRIM trim)
+{
+    clear();
+    for (auto iter: ttlib::split(str, separator, trim))
+        emplace_back(iter);
+}
 
-        start = end + separator.length();
-        if (start >= str.length())
-            break;
+void multistr::SetString(std::string_view str, std::string_view separator, tt::TRIM trim)
+{
+    clear();
+    for (auto iter: ttlib::split(str, separator, trim))
+        emplace_back(iter);
+}
 
-        end = str.find_first_of(separator, start);
-    }
+void multistr::SetString(std::string_view str, ttlib::oneof separators, tt::TRIM trim)
+{
+    clear();
+    for (auto iter: ttlib::split(str, separators, trim))
+        emplace_back(iter);
 }
 
 /////////////////////////////////////// multiview ///////////////////////////////////////
@@ -144,127 +115,20 @@ void multistr::SetString(std::string_view str, std::string_view separator, tt::T
 void multiview::SetString(std::string_view str, char separator, tt::TRIM trim)
 {
     clear();
-    size_t start = 0;
-    size_t end = str.find_first_of(separator);
-
-    // The last string will not have a separator, so end == tt::npos, but we still need to add that final string
-    for (;;)
-    {
-        emplace_back(ttlib::emptystring);
-        if (trim == tt::TRIM::both || trim == tt::TRIM::left)
-        {
-            auto begin = str.find_first_not_of(" \t\n\r\f\v", start);
-            if (begin != tt::npos)
-            {
-                start = begin;
-            }
-            else
-            {
-                if (end != tt::npos)
-                {
-                    start = end;
-                }
-                else
-                {
-                    // We're at the end, there's nothing here but whitespace, so we're done
-                    break;
-                }
-            }
-        }
-
-        if (trim == tt::TRIM::both || trim == tt::TRIM::right)
-        {
-            auto temp_end = end;
-            if (end == tt::npos)
-                temp_end = str.length();
-            while (temp_end > start && ttlib::is_whitespace(str.at(temp_end - 1)))
-            {
-                --temp_end;
-            }
-            back() = str.substr(start, temp_end - start);
-        }
-
-        else if (end == tt::npos)
-        {
-            back() = str.substr(start, str.length() - start);
-        }
-        else
-        {
-            back() = str.substr(start, end - start);
-        }
-
-        // The last string will not have a separator after it so end will already be set to tt::npos
-        if (end == tt::npos)
-            break;
-
-        start = end + sizeof(char);
-        if (start >= str.length())
-            break;
-
-        end = str.find_first_of(separator, start);
-    }
+    for (auto iter: ttlib::split(str, separator, trim))
+        push_back(iter);
 }
 
 void multiview::SetString(std::string_view str, std::string_view separator, tt::TRIM trim)
 {
     clear();
-    size_t start = 0;
-    size_t end = str.find_first_of(separator);
-
-    // The last string will not have a separator, so end == tt::npos, but we still need to add that final string
-    for (;;)
-    {
-        emplace_back(ttlib::emptystring);
-        if (trim == tt::TRIM::both || trim == tt::TRIM::left)
-        {
-            auto begin = str.find_first_not_of(" \t\n\r\f\v", start);
-            if (begin != tt::npos)
-            {
-                start = begin;
-            }
-            else
-            {
-                if (end != tt::npos)
-                {
-                    start = end;
-                }
-                else
-                {
-                    // We're at the end, there's nothing here but whitespace, so we're done
-                    break;
-                }
-            }
-        }
-
-        if (trim == tt::TRIM::both || trim == tt::TRIM::right)
-        {
-            auto temp_end = end;
-            if (end == tt::npos)
-                temp_end = str.length();
-            while (temp_end > start && ttlib::is_whitespace(str.at(temp_end - 1)))
-            {
-                --temp_end;
-            }
-            back() = str.substr(start, temp_end - start);
-        }
-
-        else if (end == tt::npos)
-        {
-            back() = str.substr(start, str.length() - start);
-        }
-        else
-        {
-            back() = str.substr(start, end - start);
-        }
-
-        // The last string will not have a separator after it so end will already be set to tt::npos
-        if (end == tt::npos)
-            break;
-
-        start = end + separator.length();
-        if (start >= str.length())
-            break;
+    for (auto iter: ttlib::split(str, separator, trim))
+        push_back(iter);
+}
 
-        end = str.find_first_of(separator, start);
-    }
+void multiview::SetString(std::string_view str, ttlib::oneof separators, tt::TRIM trim)
+{
+    clear();
+    for (auto iter: ttlib::split(str, separators, trim))
+        push_back(iter);
 }
@@ -11,10 +11,13 @@
     #error "The contents of ttmultistr_wx.h are available only with C++17 or later."
 #endif
 
+#include <iterator>  // std::bidirectional_iterator_tag
+
 #include "ttlib_wx.h"  // ttlib namespace functions and declarations
 
-#include "ttcstr_wx.h"   // cstr -- std::string with additional methods
-#include "ttsview_wx.h"  // sview -- std::string_view with additional methods
+#include "ttcstr_wx.h"         // cstr -- std::string with additional methods
+#include "ttsmallvector_wx.h"  // smallvector -- Vector that stores its first N elements without allocating
+#include "ttsview_wx.h"        // sview -- std::string_view with additional methods
 
 /// @file
 /// These two classes break a string containing substrings into a vector of substrings. Use ttlib::multistr if you want
@@ -23,9 +26,185 @@
 ///
 /// An example usage is getting the PATH$ envionment variable which contains multiple paths separated by a semicolon.
 /// Handing the PATH$ string to either of these classes would give you a vector of each individual path.
+///
+/// ttlib::split breaks the string up the same way, but only finds each substring as it is needed. Nothing is
+/// allocated, and a loop that only needs the first few fields of a long record can stop early:
+///
+///     for (auto field: ttlib::split(record, ',', tt::TRIM::both))
+///     {
+///         if (field.is_sameas("end"))
+///             break;
+///     }
+///
+/// ttlib::smallmultiview<N> and ttlib::smallmultistr<N> work the same as multiview and multistr, but store the first
+/// N substrings inside the object, so splitting a short record doesn't allocate anything:
+///
+///     ttlib::smallmultiview<4> fields(record, ',');  // no allocation unless there are more than 4 fields
 
 namespace ttlib
 {
+    /// Wraps a set of characters so that any one of them is treated as a separator. Without this, a
+    /// std::string_view separator is a sequence of characters that must match in its entirety.
+    ///
+    ///     ttlib::multiview fields(line, ttlib::oneof(",;"));
+    struct oneof
+    {
+        explicit oneof(std::string_view set) : chars(set) {}
+
+        std::string_view chars;
+    };
+
+    /// Lazy range of the substrings in a string. Each substring is returned as a ttlib::sview into the
+    /// original string, so the original string must remain valid while the range is in use.
+    ///
+    /// The substrings are the same as multiview would create: a string with no separators is a single
+    /// substring (even if it is empty), and a separator at the very end of the string does not create
+    /// a final empty substring. The range can also be iterated in reverse with rbegin() and rend().
+    class split
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = ttlib::sview;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ttlib::sview*;
+            using reference = ttlib::sview;
+
+            iterator(const split* range, size_t begin, size_t end) : m_range(range), m_begin(begin), m_end(end) {}
+
+            ttlib::sview operator*() const { return m_range->trimmed(m_begin, m_end); }
+
+            iterator& operator++()
+            {
+                m_range->next(m_begin, m_end);
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto prev = *this;
+                m_range->next(m_begin, m_end);
+                return prev;
+            }
+
+            iterator& operator--()
+            {
+                m_range->prev(m_begin, m_end);
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                auto prev = *this;
+                m_range->prev(m_begin, m_end);
+                return prev;
+            }
+
+            bool operator==(const iterator& other) const { return m_begin == other.m_begin; }
+            bool operator!=(const iterator& other) const { return m_begin != other.m_begin; }
+
+        private:
+            const split* m_range;
+
+            // Untrimmed substring is m_range->m_str[m_begin, m_end). m_begin is tt::npos for end().
+            size_t m_begin;
+            size_t m_end;
+        };
+
+        using const_iterator = iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        split(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none) :
+            m_str(str), m_sep_char(separator), m_sep_len(1), m_trim(trim)
+        {
+            init();
+        }
+
+        /// Use this when a character sequence (such as "\r\n") separates the substrings. The entire
+        /// sequence must match to be considered a separator.
+        split(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none) :
+            m_str(str), m_sep(separator), m_sep_len(separator.size()), m_trim(trim)
+        {
+            init();
+        }
+
+        /// Use this when any one of several characters separates the substrings.
+        split(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none) :
+            m_str(str), m_sep(separators.chars), m_sep_len(separators.chars.empty() ? 0 : 1), m_trim(trim),
+            m_oneof(true)
+        {
+            init();
+        }
+
+        iterator begin() const { return iterator(this, 0, find_sep(0)); }
+        iterator end() const { return iterator(this, tt::npos, tt::npos); }
+
+        reverse_iterator rbegin() const { return reverse_iterator(end()); }
+        reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+        /// Returns the first substring.
+        ttlib::sview front() const { return *begin(); }
+
+        /// Returns the last substring.
+        ttlib::sview back() const { return *(--end()); }
+
+    protected:
+        void init();
+
+        bool is_sep(size_t pos) const
+        {
+            if (m_oneof)
+                return m_sep.find(m_str[pos]) != tt::npos;
+            return m_sep.empty() ? m_str[pos] == m_sep_char : m_str.compare(pos, m_sep_len, m_sep) == 0;
+        }
+
+        // Returns the position of the next separator at or after start, or m_limit if there isn't one.
+        size_t find_sep(size_t start) const
+        {
+            if (!m_sep_len)
+                return m_limit;
+            size_t pos;
+            if (m_oneof)
+            {
+                pos = ttlib::find_oneof_pos(m_str.substr(start), m_sep);
+                if (pos != tt::npos)
+                    pos += start;
+            }
+            else
+            {
+                pos = m_sep.empty() ? m_str.find(m_sep_char, start) : m_str.find(m_sep, start);
+            }
+            return (pos < m_limit) ? pos : m_limit;
+        }
+
+        void next(size_t& begin, size_t& end) const
+        {
+            if (end >= m_limit)
+            {
+                begin = end = tt::npos;
+                return;
+            }
+            begin = end + m_sep_len;
+            end = find_sep(begin);
+        }
+
+        void prev(size_t& begin, size_t& end) const;
+
+        ttlib::sview trimmed(size_t begin, size_t end) const;
+
+    private:
+        std::string_view m_str;
+        std::string_view m_sep;  // empty if m_sep_char is the separator, set of characters if m_oneof
+        char m_sep_char { 0 };
+        size_t m_sep_len;
+        size_t m_limit;  // length of m_str without a trailing separator
+        tt::TRIM m_trim;
+        bool m_oneof { false };     // true if any character in m_sep is a separator
+        bool m_overlaps { false };  // true if the end of m_sep can also be the start of another m_sep
+    };
+
     class multistr : public std::vector<ttlib::cstr>
     {
     public:
@@ -36,15 +215,23 @@ namespace ttlib
             SetString(str, separator, trim);
         }
 
-        // Use this when a character sequence (such as "/r/n") separates the substrings
+        // Use this when a character sequence (such as "/r/n") separates the substrings. The entire
+        // sequence must match to be considered a separator.
         multistr(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none)
         {
             SetString(str, separator, trim);
         }
 
+        // Use this when any one of several characters (such as ttlib::oneof(",;")) separates the substrings
+        multistr(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separators, trim);
+        }
+
         // Clears the current vector of parsed strings and creates a new vector
         void SetString(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none);
         void SetString(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none);
+        void SetString(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none);
     };
 
     class multiview : public std::vector<ttlib::sview>
@@ -58,14 +245,112 @@ namespace ttlib
             SetString(str, separator, trim);
         }
 
-        // Use this when a character sequence (such as "/r/n") separates the substrings
+        // Use this when a character sequence (such as "/r/n") separates the substrings. The entire
+        // sequence must match to be considered a separator.
         multiview(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none)
         {
             SetString(str, separator, trim);
         }
 
+        // Use this when any one of several characters (such as ttlib::oneof(",;")) separates the substrings
+        multiview(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separators, trim);
+        }
+
         // Clears the current vector of parsed strings and creates a new vector
         void SetString(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none);
         void SetString(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none);
+        void SetString(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none);
+    };
+
+    /// Same as multistr, but the first N substrings are stored without allocating the vector.
+    template <size_t N = 8>
+    class smallmultistr : public ttlib::smallvector<ttlib::cstr, N>
+    {
+    public:
+        smallmultistr() {}
+
+        smallmultistr(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separator, trim);
+        }
+
+        smallmultistr(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separator, trim);
+        }
+
+        smallmultistr(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separators, trim);
+        }
+
+        // Clears the current vector of parsed strings and creates a new vector
+        void SetString(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none)
+        {
+            this->clear();
+            for (auto iter: ttlib::split(str, separator, trim))
+                this->emplace_back(iter);
+        }
+
+        void SetString(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none)
+        {
+            this->clear();
+            for (auto iter: ttlib::split(str, separator, trim))
+                this->emplace_back(iter);
+        }
+
+        void SetString(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none)
+        {
+            this->clear();
+            for (auto iter: ttlib::split(str, separators, trim))
+                this->emplace_back(iter);
+        }
+    };
+
+    /// Same as multiview, but the first N views are stored without allocating the vector.
+    template <size_t N = 8>
+    class smallmultiview : public ttlib::smallvector<ttlib::sview, N>
+    {
+    public:
+        smallmultiview() {}
+
+        smallmultiview(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separator, trim);
+        }
+
+        smallmultiview(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separator, trim);
+        }
+
+        smallmultiview(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none)
+        {
+            SetString(str, separators, trim);
+        }
+
+        // Clears the current vector of views and creates a new vector
+        void SetString(std::string_view str, char separator = ';', tt::TRIM trim = tt::TRIM::none)
+        {
+            this->clear();
+            for (auto iter: ttlib::split(str, separator, trim))
+                this->push_back(iter);
+        }
+
+        void SetString(std::string_view str, std::string_view separator, tt::TRIM trim = tt::TRIM::none)
+        {
+            this->clear();
+            for (auto iter: ttlib::split(str, separator, trim))
+                this->push_back(iter);
+        }
+
+        void SetString(std::string_view str, ttlib::oneof separators, tt::TRIM trim = tt::TRIM::none)
+        {
+            this->clear();
+            for (auto iter: ttlib::split(str, separators, trim))
+                this->push_back(iter);
+        }
     };
 }  // namespace ttlib
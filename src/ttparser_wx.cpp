@@ -119,20 +119,15 @@ cmd::Option* cmd::findOption(std::string_view option) const
 {
     assert(!option.empty());
 
-    ttlib::cstr longname;
+    std::string_view longname = option;
     if (auto pos = option.find('|'); ttlib::is_found(pos))
     {
-        longname.assign(option.substr(pos + 1));
+        longname = option.substr(pos + 1);
     }
-    else
+    else if (option.size() < 2)
     {
-        longname.assign(option);
-        if (option.size() < 2)
-        {
-            auto entry = m_shortlong.find(longname);
-            if (entry != m_shortlong.end())
-                longname = entry->second;
-        }
+        if (auto entry = m_shortlong.find(option); entry != m_shortlong.end())
+            longname = entry->second;
     }
 
     if (auto entry = m_options.find(longname); entry != m_options.end())
@@ -30,6 +30,7 @@
 ///
 /// @endcode
 
+#include <functional>  // std::less<>
 #include <map>
 #include <memory>
 #include <optional>
@@ -168,8 +169,11 @@ namespace ttlib
             size_t m_setvalue;
         };
 
-        std::map<std::string, std::string> m_shortlong;  // maps short name to long name
-        std::map<std::string, std::unique_ptr<Option>> m_options;
+        // std::less<> allows both maps to be searched with a std::string_view without constructing a
+        // temporary std::string.
+
+        std::map<std::string, std::string, std::less<>> m_shortlong;  // maps short name to long name
+        std::map<std::string, std::unique_ptr<Option>, std::less<>> m_options;
 
         size_t m_sharedvalue { tt::npos };
 
@@ -0,0 +1,298 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Lexical path operations that don't access the file system
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include <system_error>  // std::error_code
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttpath_wx.h>
+
+namespace
+{
+#if defined(_WIN32)
+    constexpr tt::CASE path_case = tt::CASE::either;
+#else
+    constexpr tt::CASE path_case = tt::CASE::exact;
+#endif
+
+    inline bool is_sep(char ch) noexcept
+    {
+#if defined(_WIN32)
+        return ch == '/' || ch == '\\';
+#else
+        return ch == '/';
+#endif
+    }
+
+    // Returns the length of the root of path: a drive or server name on Windows, followed by any
+    // separators. has_root_dir is set if the root includes a separator.
+    size_t root_length(std::string_view path, bool& has_root_dir) noexcept
+    {
+        size_t pos = 0;
+#if defined(_WIN32)
+        if (path.size() >= 2 && ttlib::is_alpha(path[0]) && path[1] == ':')
+        {
+            pos = 2;
+        }
+        else if (path.size() > 2 && is_sep(path[0]) && is_sep(path[1]) && !is_sep(path[2]))
+        {
+            // "//server" is the root name of a UNC path
+            pos = 2;
+            while (pos < path.size() && !is_sep(path[pos]))
+                ++pos;
+        }
+#endif
+        has_root_dir = pos < path.size() && is_sep(path[pos]);
+        while (pos < path.size() && is_sep(path[pos]))
+            ++pos;
+        return pos;
+    }
+
+    // Appends the root of path to dest using '/' as the separator. Returns the length of the
+    // root in path.
+    size_t append_root(std::string_view path, std::string& dest, bool& has_root_dir)
+    {
+        auto len = root_length(path, has_root_dir);
+        auto name_len = len;
+        while (name_len && is_sep(path[name_len - 1]))
+            --name_len;
+        for (size_t pos = 0; pos < name_len; ++pos)
+            dest += is_sep(path[pos]) ? '/' : path[pos];
+        if (has_root_dir)
+            dest += '/';
+        return len;
+    }
+
+    // Returns the component that starts at pos and moves pos past it and any separators after it.
+    std::string_view next_component(std::string_view path, size_t& pos) noexcept
+    {
+        auto start = pos;
+        while (pos < path.size() && !is_sep(path[pos]))
+            ++pos;
+        auto component = path.substr(start, pos - start);
+        while (pos < path.size() && is_sep(path[pos]))
+            ++pos;
+        return component;
+    }
+
+    std::string get_cwd()
+    {
+        std::error_code ec;
+        auto cwd = std::filesystem::current_path(ec);
+        if (ec)
+            return {};
+#if defined(_WIN32)
+        std::string result;
+        ttlib::utf16to8(cwd.wstring(), result);
+        return result;
+#else
+        return cwd.string();
+#endif
+    }
+}  // anonymous namespace
+
+bool ttlib::is_absolute_path(std::string_view path) noexcept
+{
+    bool has_root_dir;
+    auto len = root_length(path, has_root_dir);
+#if defined(_WIN32)
+    // "C:/dir" and "//server/share" are absolute, but "/dir" is relative to the current drive and
+    // "C:dir" is relative to the current directory of drive C.
+    return (has_root_dir && !is_sep(path[0])) || (len > 2 && is_sep(path[0]) && is_sep(path[1]));
+#else
+    (void) len;
+    return has_root_dir;
+#endif
+}
+
+void ttlib::path_normalize(std::string_view path, std::string& dest)
+{
+    dest.clear();
+    bool has_root_dir;
+    auto pos = append_root(path, dest, has_root_dir);
+    const auto root_len = dest.size();
+
+    bool trailing_sep = false;
+    while (pos < path.size())
+    {
+        auto component = next_component(path, pos);
+        if (component == ".")
+        {
+            trailing_sep = true;
+            continue;
+        }
+
+        if (component == "..")
+        {
+            // Remove the previous component unless it is also "..".
+            auto last_sep = dest.find_last_of('/');
+            auto last_start = (last_sep == std::string::npos || last_sep < root_len) ? root_len : last_sep + 1;
+            if (dest.size() > root_len && std::string_view(dest).substr(last_start) != "..")
+            {
+                dest.erase(last_start > root_len ? last_start - 1 : root_len);
+                trailing_sep = true;
+                continue;
+            }
+            if (has_root_dir)
+                continue;  // ".." at the root is still the root
+        }
+
+        if (dest.size() > root_len)
+            dest += '/';
+        dest += component;
+        trailing_sep = (pos == path.size() && is_sep(path.back()));
+    }
+
+    if (dest.empty())
+    {
+        dest = ".";
+    }
+    else if (trailing_sep && dest.size() > root_len && dest.back() != '/')
+    {
+        // A trailing separator is kept, except after ".."
+        auto last_sep = dest.find_last_of('/');
+        if (std::string_view(dest).substr(last_sep == std::string::npos ? 0 : last_sep + 1) != "..")
+            dest += '/';
+    }
+}
+
+void ttlib::path_join(std::string_view dir, std::string_view name, std::string& dest)
+{
+    if (dir.empty() || ttlib::is_absolute_path(name))
+    {
+        dest.assign(name);
+        return;
+    }
+
+    dest.assign(dir);
+    if (name.size())
+    {
+        if (!is_sep(dest.back()))
+            dest += '/';
+        dest += name;
+    }
+}
+
+bool ttlib::path_relative(std::string_view path, std::string_view base, std::string& dest)
+{
+    thread_local std::string norm_path;
+    thread_local std::string norm_base;
+    ttlib::path_normalize(path, norm_path);
+    ttlib::path_normalize(base, norm_base);
+    dest.clear();
+
+    bool path_root_dir;
+    bool base_root_dir;
+    auto path_pos = root_length(norm_path, path_root_dir);
+    auto base_pos = root_length(norm_base, base_root_dir);
+    if (path_root_dir != base_root_dir ||
+        !ttlib::is_sameas(std::string_view(norm_path).substr(0, path_pos),
+                          std::string_view(norm_base).substr(0, base_pos), path_case))
+    {
+        return false;
+    }
+    if (norm_path == ".")
+        path_pos = norm_path.size();
+    if (norm_base == ".")
+        base_pos = norm_base.size();
+
+    // Skip the components that are the same in both paths.
+    while (path_pos < norm_path.size() && base_pos < norm_base.size())
+    {
+        auto save_path = path_pos;
+        auto save_base = base_pos;
+        if (!ttlib::is_sameas(next_component(norm_path, path_pos), next_component(norm_base, base_pos), path_case))
+        {
+            path_pos = save_path;
+            base_pos = save_base;
+            break;
+        }
+    }
+
+    // Every component left in base is a directory to go up from -- unless it is "..", in which
+    // case the name of the directory that was moved up into would be needed.
+    while (base_pos < norm_base.size())
+    {
+        if (next_component(norm_base, base_pos) == "..")
+        {
+            dest.clear();
+            return false;
+        }
+        dest += dest.empty() ? ".." : "/..";
+    }
+
+    if (path_pos < norm_path.size())
+    {
+        if (dest.size())
+            dest += '/';
+        dest += std::string_view(norm_path).substr(path_pos);
+    }
+    if (dest.empty())
+        dest = ".";
+    return true;
+}
+
+void ttlib::path_absolute(std::string_view path, std::string& dest)
+{
+    if (ttlib::is_absolute_path(path))
+    {
+        ttlib::path_normalize(path, dest);
+        return;
+    }
+
+    thread_local std::string joined;
+    auto cwd = get_cwd();
+#if defined(_WIN32)
+    bool has_root_dir;
+    auto len = root_length(path, has_root_dir);
+    if (len && has_root_dir && is_sep(path[0]))
+    {
+        // "/dir" is on the current drive
+        bool cwd_root_dir;
+        auto cwd_len = root_length(cwd, cwd_root_dir);
+        while (cwd_len && is_sep(cwd[cwd_len - 1]))
+            --cwd_len;
+        joined.assign(cwd, 0, cwd_len);
+        joined += path;
+        ttlib::path_normalize(joined, dest);
+        return;
+    }
+    if (len)
+    {
+        // "C:dir" is relative to the current directory of drive C, which only the system knows.
+        std::error_code ec;
+        auto abs_path = std::filesystem::absolute(std::filesystem::path(ttlib::utf8to16(path)), ec);
+        joined.clear();
+        ttlib::utf16to8(abs_path.wstring(), joined);
+        ttlib::path_normalize(joined, dest);
+        return;
+    }
+#endif
+    ttlib::path_join(cwd, path, joined);
+    ttlib::path_normalize(joined, dest);
+}
+
+bool ttlib::path_resolve(std::string_view path, std::string& dest)
+{
+    ttlib::path_absolute(path, dest);
+
+    std::error_code ec;
+#if defined(_WIN32)
+    auto resolved = std::filesystem::weakly_canonical(std::filesystem::path(ttlib::utf8to16(dest)), ec);
+    if (ec)
+        return false;
+    dest.clear();
+    ttlib::utf16to8(resolved.generic_wstring(), dest);
+#else
+    auto resolved = std::filesystem::weakly_canonical(std::filesystem::path(dest), ec);
+    if (ec)
+        return false;
+    dest = resolved.generic_string();
+#endif
+    return true;
+}
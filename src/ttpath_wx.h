@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Lexical path operations that don't access the file system
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttpath_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// These functions work on UTF-8 paths purely as strings -- unlike std::filesystem::path, there is
+/// no conversion to the native encoding and no temporary path objects. The result is written to a
+/// std::string supplied by the caller, so a loop that reuses the same string stops allocating once
+/// the string is large enough:
+///
+///     std::string normalized;
+///     for (auto& file: files)
+///     {
+///         ttlib::path_normalize(file, normalized);
+///         ...
+///     }
+///
+/// Results always use '/' as the separator. On Windows, both '/' and '\' are accepted as
+/// separators, and paths can start with a drive ("C:/") or a server name ("//server/share").
+///
+/// Only path_absolute() (which needs the current directory when the path is relative) and
+/// path_resolve() (which resolves symbolic links) access the file system. The destination string
+/// must not be one of the strings passed in.
+
+#include <string>
+#include <string_view>
+
+namespace ttlib
+{
+    /// Returns true if path starts at the root of the file system.
+    bool is_absolute_path(std::string_view path) noexcept;
+
+    /// Sets dest to path with duplicate separators and "." components removed, and with each ".."
+    /// component removing the component before it. A trailing separator is kept. An empty result
+    /// is returned as ".".
+    void path_normalize(std::string_view path, std::string& dest);
+
+    /// Sets dest to dir followed by name, adding a separator if needed. If name is an absolute
+    /// path, dest is set to name.
+    void path_join(std::string_view dir, std::string_view name, std::string& dest);
+
+    /// Sets dest to a path that refers to path when the current directory is base. Both paths are
+    /// normalized first.
+    ///
+    /// Returns false (and sets dest to an empty string) if this can't be done without knowing the
+    /// current directory: one path is absolute and the other isn't, they are on different drives,
+    /// or base goes further above the current directory than path does.
+    bool path_relative(std::string_view path, std::string_view base, std::string& dest);
+
+    /// Sets dest to the normalized absolute form of path. The current directory is only read if
+    /// path is relative.
+    void path_absolute(std::string_view path, std::string& dest);
+
+    /// Same as path_absolute(), but symbolic links are resolved in the portion of path that exists.
+    /// Returns false if the file system reports an error, in which case dest is the result of
+    /// path_absolute().
+    bool path_resolve(std::string_view path, std::string& dest);
+}  // namespace ttlib
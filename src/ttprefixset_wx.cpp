@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Sorted set of strings optimized for prefix searches
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <numeric>  // std::iota
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttprefixset_wx.h>
+
+using namespace ttlib;
+
+namespace
+{
+    inline unsigned char fold(char ch) noexcept
+    {
+        auto uch = static_cast<unsigned char>(ch);
+        return (uch >= 'A' && uch <= 'Z') ? static_cast<unsigned char>(uch + ('a' - 'A')) : uch;
+    }
+
+    // Compares two strings ignoring ASCII case. Returns <0, 0 or >0.
+    int compare_folded(std::string_view str1, std::string_view str2) noexcept
+    {
+        auto len = std::min(str1.size(), str2.size());
+        for (size_t pos = 0; pos < len; ++pos)
+        {
+            auto ch1 = fold(str1[pos]);
+            auto ch2 = fold(str2[pos]);
+            if (ch1 != ch2)
+                return (ch1 < ch2) ? -1 : 1;
+        }
+        return (str1.size() < str2.size()) ? -1 : (str1.size() > str2.size() ? 1 : 0);
+    }
+
+    // Compares only the first prefix.size() characters of str against prefix.
+    template <bool ignore_case>
+    int compare_prefix(std::string_view str, std::string_view prefix) noexcept
+    {
+        str = str.substr(0, prefix.size());
+        if constexpr (ignore_case)
+            return compare_folded(str, prefix);
+        else
+            return str.compare(prefix);
+    }
+}  // anonymous namespace
+
+void prefixset::assign(const std::vector<ttlib::cstr>& strings)
+{
+    m_strings.assign(strings.begin(), strings.end());
+    std::sort(m_strings.begin(), m_strings.end());
+    m_strings.erase(std::unique(m_strings.begin(), m_strings.end()), m_strings.end());
+    build_folded();
+}
+
+// m_folded is sorted ignoring case, and strings that only differ in case are kept in exact sort
+// order.
+bool prefixset::folded_less(uint32_t left, uint32_t right) const
+{
+    auto result = compare_folded(m_strings[left], m_strings[right]);
+    return (result != 0) ? (result < 0) : (left < right);
+}
+
+void prefixset::build_folded()
+{
+    m_folded.resize(m_strings.size());
+    std::iota(m_folded.begin(), m_folded.end(), 0);
+    std::sort(m_folded.begin(), m_folded.end(), [this](uint32_t left, uint32_t right) { return folded_less(left, right); });
+}
+
+bool prefixset::insert(std::string_view str)
+{
+    auto iter = std::lower_bound(m_strings.begin(), m_strings.end(), str,
+                                 [](const ttlib::cstr& left, std::string_view right) { return left.compare(right) < 0; });
+    if (iter != m_strings.end() && iter->compare(str) == 0)
+        return false;
+
+    auto added = static_cast<uint32_t>(iter - m_strings.begin());
+    m_strings.emplace(iter, str);
+
+    // Every string after the new one has moved up one position.
+    for (auto& pos: m_folded)
+    {
+        if (pos >= added)
+            ++pos;
+    }
+    m_folded.insert(std::lower_bound(m_folded.begin(), m_folded.end(), added,
+                                     [this](uint32_t left, uint32_t right) { return folded_less(left, right); }),
+                    added);
+    return true;
+}
+
+bool prefixset::erase(std::string_view str)
+{
+    auto iter = std::lower_bound(m_strings.begin(), m_strings.end(), str,
+                                 [](const ttlib::cstr& left, std::string_view right) { return left.compare(right) < 0; });
+    if (iter == m_strings.end() || iter->compare(str) != 0)
+        return false;
+
+    auto removed = static_cast<uint32_t>(iter - m_strings.begin());
+    m_folded.erase(std::find(m_folded.begin(), m_folded.end(), removed));
+    for (auto& pos: m_folded)
+    {
+        if (pos > removed)
+            --pos;
+    }
+    m_strings.erase(iter);
+    return true;
+}
+
+bool prefixset::contains(std::string_view str, tt::CASE checkcase) const
+{
+    // Every string in the range begins with str, and a string that is the same length as str sorts
+    // before any longer one. If the first string in the range is longer, none of them can match.
+    auto range = prefix_range(str, checkcase);
+    return range.first < range.second && get(range.first, checkcase).size() == str.size();
+}
+
+std::pair<size_t, size_t> prefixset::prefix_range(std::string_view prefix, tt::CASE checkcase) const
+{
+    if (checkcase == tt::CASE::exact)
+    {
+        auto first = std::lower_bound(m_strings.begin(), m_strings.end(), prefix,
+                                      [](const ttlib::cstr& str, std::string_view value)
+                                      { return compare_prefix<false>(str, value) < 0; });
+        auto last = std::upper_bound(first, m_strings.end(), prefix,
+                                     [](std::string_view value, const ttlib::cstr& str)
+                                     { return compare_prefix<false>(str, value) > 0; });
+        return { static_cast<size_t>(first - m_strings.begin()), static_cast<size_t>(last - m_strings.begin()) };
+    }
+
+    auto first = std::lower_bound(m_folded.begin(), m_folded.end(), prefix,
+                                  [this](uint32_t pos, std::string_view value)
+                                  { return compare_prefix<true>(m_strings[pos], value) < 0; });
+    auto last = std::upper_bound(first, m_folded.end(), prefix,
+                                 [this](std::string_view value, uint32_t pos)
+                                 { return compare_prefix<true>(m_strings[pos], value) > 0; });
+    return { static_cast<size_t>(first - m_folded.begin()), static_cast<size_t>(last - m_folded.begin()) };
+}
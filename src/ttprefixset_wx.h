@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Sorted set of strings optimized for prefix searches
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttprefixset_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::prefixset stores a sorted, unique set of strings. Because strings that share a prefix
+/// are always adjacent once sorted, all of the strings beginning with a prefix can be found with
+/// two binary searches, no matter how many strings are in the set. A second index sorts the
+/// strings ignoring ASCII case so that case-insensitive prefix searches are just as fast.
+///
+///     ttlib::prefixset symbols(all_symbols);
+///     symbols.enumerate("wxBit", [](const ttlib::cstr& name) { ... }, tt::CASE::either);
+///
+/// Unlike ttlib::is_sameprefix(), an empty prefix matches every string.
+
+#include <cstdint>      // uint32_t
+#include <string_view>  // std::string_view
+#include <utility>      // std::pair
+#include <vector>
+
+#include "ttcstr_wx.h"  // cstr -- std::string with additional methods
+
+namespace ttlib
+{
+    class prefixset
+    {
+    public:
+        prefixset() = default;
+
+        /// Copies all of the strings in the vector (including a ttlib::cstrVector). Duplicate
+        /// strings are only stored once.
+        prefixset(const std::vector<ttlib::cstr>& strings) { assign(strings); }
+
+        /// Replaces the current strings with a copy of the strings in the vector. Duplicate
+        /// strings are only stored once.
+        void assign(const std::vector<ttlib::cstr>& strings);
+
+        /// Adds a string if it isn't already in the set, returning true if it was added. Each
+        /// insertion moves the strings that sort after it, so call assign() when adding a large
+        /// number of strings.
+        bool insert(std::string_view str);
+
+        /// Removes the string if it exists, returning true if it was removed.
+        bool erase(std::string_view str);
+
+        void clear()
+        {
+            m_strings.clear();
+            m_folded.clear();
+        }
+
+        size_t size() const { return m_strings.size(); }
+        bool empty() const { return m_strings.empty(); }
+
+        /// Strings are sorted by their exact (byte) value.
+        const ttlib::cstr& operator[](size_t pos) const { return m_strings[pos]; }
+        auto begin() const { return m_strings.begin(); }
+        auto end() const { return m_strings.end(); }
+
+        /// Returns true if the set contains str. CASE::utf8 is treated as CASE::either.
+        bool contains(std::string_view str, tt::CASE checkcase = tt::CASE::exact) const;
+
+        /// Returns true if any string in the set begins with prefix.
+        bool has_prefix(std::string_view prefix, tt::CASE checkcase = tt::CASE::exact) const
+        {
+            auto range = prefix_range(prefix, checkcase);
+            return range.first < range.second;
+        }
+
+        /// Returns the number of strings that begin with prefix.
+        size_t count_prefix(std::string_view prefix, tt::CASE checkcase = tt::CASE::exact) const
+        {
+            auto range = prefix_range(prefix, checkcase);
+            return range.second - range.first;
+        }
+
+        /// Returns the first string (in sort order) that begins with prefix, or nullptr if there
+        /// isn't one.
+        const ttlib::cstr* find_prefix(std::string_view prefix, tt::CASE checkcase = tt::CASE::exact) const
+        {
+            auto range = prefix_range(prefix, checkcase);
+            return (range.first < range.second) ? &get(range.first, checkcase) : nullptr;
+        }
+
+        /// Calls func(const ttlib::cstr&) for every string that begins with prefix. CASE::exact
+        /// results are in exact sort order, other results are sorted ignoring ASCII case.
+        template <typename Func>
+        void enumerate(std::string_view prefix, Func&& func, tt::CASE checkcase = tt::CASE::exact) const
+        {
+            auto range = prefix_range(prefix, checkcase);
+            for (auto pos = range.first; pos < range.second; ++pos)
+                func(get(pos, checkcase));
+        }
+
+        /// Returns the half-open range of positions of strings that begin with prefix. For
+        /// CASE::exact the positions can be used with operator[]. For other CASE values they are
+        /// positions in the case-insensitive index and must be passed to get().
+        std::pair<size_t, size_t> prefix_range(std::string_view prefix, tt::CASE checkcase = tt::CASE::exact) const;
+
+        /// Returns a string using a position returned by prefix_range().
+        const ttlib::cstr& get(size_t pos, tt::CASE checkcase = tt::CASE::exact) const
+        {
+            return (checkcase == tt::CASE::exact) ? m_strings[pos] : m_strings[m_folded[pos]];
+        }
+
+    protected:
+        void build_folded();
+        bool folded_less(uint32_t left, uint32_t right) const;
+
+    private:
+        std::vector<ttlib::cstr> m_strings;  // sorted by exact value
+        std::vector<uint32_t> m_folded;      // positions in m_strings sorted ignoring ASCII case
+    };
+}  // namespace ttlib
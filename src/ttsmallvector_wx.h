@@ -0,0 +1,302 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Vector that stores its first N elements without allocating
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttsmallvector_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::smallvector<T, N> has the same interface as the commonly used parts of std::vector, but
+/// the first N elements are stored inside the object itself. Nothing is allocated until an N + 1
+/// element is added, at which point all the elements are moved to the heap the same way
+/// std::vector would grow.
+///
+/// This is useful for short-lived vectors that usually only hold a few elements -- for example,
+/// ttlib::smallmultiview splits a string into views without allocating as long as there are no
+/// more than N substrings.
+
+#include <cstddef>           // std::size_t
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::reverse_iterator
+#include <memory>            // std::uninitialized_move, std::unique_ptr
+#include <new>               // placement new
+#include <stdexcept>         // std::out_of_range
+#include <type_traits>       // std::is_nothrow_move_constructible
+#include <utility>           // std::move, std::forward
+
+namespace ttlib
+{
+    template <class T, size_t N = 8>
+    class smallvector
+    {
+    public:
+        static_assert(N > 0, "smallvector must have room for at least one element");
+
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        smallvector() {}
+
+        smallvector(std::initializer_list<T> init)
+        {
+            reserve(init.size());
+            for (auto& iter: init)
+                emplace_back(iter);
+        }
+
+        smallvector(const smallvector& other)
+        {
+            reserve(other.m_size);
+            for (auto& iter: other)
+                emplace_back(iter);
+        }
+
+        smallvector(smallvector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) { take(other); }
+
+        ~smallvector()
+        {
+            clear();
+            release();
+        }
+
+        smallvector& operator=(const smallvector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.m_size);
+                for (auto& iter: other)
+                    emplace_back(iter);
+            }
+            return *this;
+        }
+
+        smallvector& operator=(smallvector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                clear();
+                release();
+                take(other);
+            }
+            return *this;
+        }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_size == m_capacity)
+                return grow_emplace(std::forward<Args>(args)...);
+            auto* item = new (m_data + m_size) T(std::forward<Args>(args)...);
+            ++m_size;
+            return *item;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        void pop_back()
+        {
+            --m_size;
+            m_data[m_size].~T();
+        }
+
+        /// Removes the element at pos, moving every element after it down one position. Returns
+        /// an iterator to the element that followed the removed one.
+        iterator erase(const_iterator pos)
+        {
+            auto* item = m_data + (pos - m_data);
+            for (auto* next = item + 1; next != m_data + m_size; ++next)
+                *(next - 1) = std::move(*next);
+            pop_back();
+            return item;
+        }
+
+        /// Destroys every element. Heap storage (if any) is kept for reuse.
+        void clear() noexcept
+        {
+            for (size_t pos = 0; pos < m_size; ++pos)
+                m_data[pos].~T();
+            m_size = 0;
+        }
+
+        void reserve(size_t count)
+        {
+            if (count > m_capacity)
+                reallocate(count);
+        }
+
+        void resize(size_t count)
+        {
+            reserve(count);
+            while (m_size > count)
+                pop_back();
+            while (m_size < count)
+                emplace_back();
+        }
+
+        size_t size() const noexcept { return m_size; }
+        size_t capacity() const noexcept { return m_capacity; }
+        bool empty() const noexcept { return m_size == 0; }
+
+        /// Returns true if the elements are stored inside the object rather than on the heap.
+        bool is_inline() const noexcept { return m_data == inline_data(); }
+
+        T* data() noexcept { return m_data; }
+        const T* data() const noexcept { return m_data; }
+
+        T& operator[](size_t pos) { return m_data[pos]; }
+        const T& operator[](size_t pos) const { return m_data[pos]; }
+
+        T& at(size_t pos)
+        {
+            if (pos >= m_size)
+                throw std::out_of_range("ttlib::smallvector::at");
+            return m_data[pos];
+        }
+
+        const T& at(size_t pos) const
+        {
+            if (pos >= m_size)
+                throw std::out_of_range("ttlib::smallvector::at");
+            return m_data[pos];
+        }
+
+        T& front() { return m_data[0]; }
+        const T& front() const { return m_data[0]; }
+        T& back() { return m_data[m_size - 1]; }
+        const T& back() const { return m_data[m_size - 1]; }
+
+        iterator begin() noexcept { return m_data; }
+        iterator end() noexcept { return m_data + m_size; }
+        const_iterator begin() const noexcept { return m_data; }
+        const_iterator end() const noexcept { return m_data + m_size; }
+        const_iterator cbegin() const noexcept { return m_data; }
+        const_iterator cend() const noexcept { return m_data + m_size; }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        bool operator==(const smallvector& other) const
+        {
+            if (m_size != other.m_size)
+                return false;
+            for (size_t pos = 0; pos < m_size; ++pos)
+            {
+                if (!(m_data[pos] == other.m_data[pos]))
+                    return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const smallvector& other) const { return !(*this == other); }
+
+    protected:
+        T* inline_data() noexcept { return reinterpret_cast<T*>(m_inline); }
+        const T* inline_data() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+        // Frees heap storage that was allocated with ::operator new but doesn't hold any elements.
+        struct storage_deleter
+        {
+            void operator()(T* ptr) const noexcept { ::operator delete(ptr); }
+        };
+        using storage_ptr = std::unique_ptr<T, storage_deleter>;
+
+        // Moves the elements into heap storage with room for count elements. The new storage is
+        // freed if moving an element throws.
+        void reallocate(size_t count)
+        {
+            storage_ptr storage(static_cast<T*>(::operator new(count * sizeof(T))));
+            std::uninitialized_move(m_data, m_data + m_size, storage.get());
+            auto size = m_size;
+            clear();
+            release();
+            m_data = storage.release();
+            m_size = size;
+            m_capacity = count;
+        }
+
+        // The new element is constructed before the existing elements are moved, since args may
+        // refer to one of them. If constructing or moving throws, the new element is destroyed and
+        // the new storage is freed.
+        template <class... Args>
+        T& grow_emplace(Args&&... args)
+        {
+            auto count = m_capacity * 2;
+            storage_ptr storage(static_cast<T*>(::operator new(count * sizeof(T))));
+            auto* item = new (storage.get() + m_size) T(std::forward<Args>(args)...);
+            try
+            {
+                std::uninitialized_move(m_data, m_data + m_size, storage.get());
+            }
+            catch (...)
+            {
+                item->~T();
+                throw;
+            }
+            auto size = m_size;
+            clear();
+            release();
+            m_data = storage.release();
+            m_size = size + 1;
+            m_capacity = count;
+            return *item;
+        }
+
+        // Frees heap storage. The elements must already have been destroyed.
+        void release() noexcept
+        {
+            if (!is_inline())
+            {
+                ::operator delete(m_data);
+                m_data = inline_data();
+                m_capacity = N;
+            }
+        }
+
+        // Takes over the elements of other. This vector must be empty and using inline storage.
+        // Heap storage is taken as is, inline elements have to be moved one at a time.
+        void take(smallvector& other)
+        {
+            if (other.is_inline())
+            {
+                std::uninitialized_move(other.m_data, other.m_data + other.m_size, m_data);
+                m_size = other.m_size;
+                other.clear();
+            }
+            else
+            {
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_data = other.inline_data();
+                other.m_size = 0;
+                other.m_capacity = N;
+            }
+        }
+
+    private:
+        alignas(T) unsigned char m_inline[N * sizeof(T)];
+        T* m_data { inline_data() };
+        size_t m_size { 0 };
+        size_t m_capacity { N };
+    };
+}  // namespace ttlib
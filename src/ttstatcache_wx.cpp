@@ -0,0 +1,199 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Cache of file and directory existence checks
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include <system_error>  // std::error_code
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttstatcache_wx.h>
+
+using namespace ttlib;
+
+namespace
+{
+    std::atomic<ttlib::statcache*> g_statcache { nullptr };
+
+    std::filesystem::path to_path(std::string_view path)
+    {
+#if defined(_WIN32)
+        std::wstring str16;
+        ttlib::utf8to16(path, str16);
+        return std::filesystem::path(str16);
+#else
+        return std::filesystem::path(path);
+#endif
+    }
+
+    // Returns the position of the separator before the last component of path, or tt::npos if
+    // the last component can't be looked up in a primed listing.
+    size_t find_parent_sep(std::string_view path)
+    {
+        auto pos = path.find_last_of("/\\");
+        if (pos == tt::npos || pos == 0 || path[pos] != '/' || pos + 1 == path.size())
+            return tt::npos;
+        auto name = path.substr(pos + 1);
+        if (name == "." || name == "..")
+            return tt::npos;
+        return pos;
+    }
+}  // anonymous namespace
+
+// Windows file systems (and macOS by default) ignore case, so the cache has to as well, or a
+// primed listing would report a path as missing just because its case is different.
+#if defined(_WIN32) || defined(__APPLE__)
+statcache::statcache(std::chrono::milliseconds ttl) : m_entries(tt::CASE::either), m_ttl(ttl) {}
+#else
+statcache::statcache(std::chrono::milliseconds ttl) : m_entries(tt::CASE::exact), m_ttl(ttl) {}
+#endif
+
+tt::PATHTYPE statcache::status(std::string_view path)
+{
+    if (path.empty())
+        return tt::PATHTYPE::missing;
+
+    const auto ttl = m_ttl.load();
+    const auto now = get_now(ttl);
+    const auto changes = m_changes.load();
+    const auto generation = m_generation.load();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto* item = m_entries.get(path); item && is_current(*item, now, ttl))
+            return item->type;
+
+        // If the parent directory was primed and path wasn't in the listing, it doesn't exist.
+        if (auto sep = find_parent_sep(path); sep != tt::npos)
+        {
+            if (auto* parent = m_entries.get(path.substr(0, sep));
+                parent && parent->listed && is_current(*parent, now, ttl))
+                return tt::PATHTYPE::missing;
+        }
+    }
+
+    auto type = query(path);
+
+    // If the cache was invalidated while the file system was being queried, the result may
+    // already be out of date, so it is returned without being cached.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_changes == changes)
+        store(path, type, false, now, generation);
+    return type;
+}
+
+bool statcache::prime(std::string_view dir)
+{
+    while (dir.size() > 1 && dir.back() == '/')
+        dir.remove_suffix(1);
+    if (dir.empty())
+        return false;
+
+    const auto now = get_now(m_ttl.load());
+    const auto changes = m_changes.load();
+    const auto generation = m_generation.load();
+
+    std::error_code ec;
+    std::filesystem::directory_iterator iter(to_path(dir), ec);
+    if (ec)
+        return false;
+
+    // The listing is read before locking so that other threads aren't blocked while the directory
+    // is read. The directory_entry type is usually filled in by the listing itself, so only
+    // symbolic links need a separate call to the file system.
+    ttlib::cstr path(dir);
+    if (path.back() != '/')
+        path += '/';
+    const auto dir_len = path.size();
+    std::vector<std::pair<ttlib::cstr, tt::PATHTYPE>> found;
+    for (; iter != std::filesystem::directory_iterator(); iter.increment(ec))
+    {
+        if (ec)
+            return false;
+        path.resize(dir_len);
+#if defined(_WIN32)
+        ttlib::utf16to8(iter->path().filename().wstring(), path);
+#else
+        path += iter->path().filename().string();
+#endif
+        std::error_code type_ec;
+        tt::PATHTYPE type = tt::PATHTYPE::missing;
+        if (iter->is_directory(type_ec))
+            type = tt::PATHTYPE::directory;
+        else if (iter->exists(type_ec))
+            type = tt::PATHTYPE::file;
+        found.emplace_back(path, type);
+    }
+    if (ec)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_changes != changes)
+        return true;  // the listing was read, but it may already be out of date
+    for (auto& [name, type]: found)
+        store(name, type, false, now, generation);
+    store(dir, tt::PATHTYPE::directory, true, now, generation);
+    return true;
+}
+
+void statcache::invalidate() noexcept
+{
+    ++m_changes;
+    ++m_generation;
+}
+
+void statcache::invalidate(std::string_view path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_changes;
+
+    // Setting an entry to the previous generation means it can never be current again.
+    if (auto* item = m_entries.get(path); item)
+        item->generation = m_generation - 1;
+    if (auto sep = find_parent_sep(path); sep != tt::npos)
+    {
+        if (auto* parent = m_entries.get(path.substr(0, sep)); parent)
+            parent->listed = false;
+    }
+}
+
+void statcache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+// m_mutex must be locked before calling this.
+void statcache::store(std::string_view path, tt::PATHTYPE type, bool listed, std::chrono::steady_clock::time_point now,
+                      uint32_t generation)
+{
+    auto& item = m_entries[path];
+    item.checked = now;
+    item.generation = generation;
+    item.type = type;
+    item.listed = listed;
+}
+
+tt::PATHTYPE statcache::query(std::string_view path)
+{
+    if (path.empty())
+        return tt::PATHTYPE::missing;
+
+    std::error_code ec;
+    auto status = std::filesystem::status(to_path(path), ec);
+    if (ec || !std::filesystem::exists(status))
+        return tt::PATHTYPE::missing;
+    return std::filesystem::is_directory(status) ? tt::PATHTYPE::directory : tt::PATHTYPE::file;
+}
+
+void statcache::set_global(ttlib::statcache* cache) noexcept
+{
+    g_statcache.store(cache);
+}
+
+ttlib::statcache* statcache::global() noexcept
+{
+    return g_statcache.load(std::memory_order_acquire);
+}
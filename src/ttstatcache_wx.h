@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Cache of file and directory existence checks
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttstatcache_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::statcache remembers whether a path is a file, a directory, or doesn't exist, so that
+/// checking the same path again is a hash lookup instead of a call to the file system. Paths that
+/// don't exist are cached as well.
+///
+/// The cache is opt-in. Once a cache has been installed with statcache::set_global(), every call to
+/// ttlib::file_exists(), ttlib::dir_exists() and the file_exists()/dir_exists() methods of cstr,
+/// sview and ttString uses it:
+///
+///     ttlib::statcache cache;
+///     ttlib::statcache::set_global(&cache);
+///     cache.prime("src/include");  // one directory listing answers every check in src/include
+///     ...
+///     ttlib::statcache::set_global(nullptr);
+///
+/// Cached results can be invalidated all at once with invalidate() (cheap -- it just starts a new
+/// generation), one path at a time, or automatically by giving the cache a time-to-live.
+///
+/// The cache is thread-safe. Paths are cached exactly as they are passed, so "src/file.h" and
+/// "./src/file.h" are two different entries.
+
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdint>      // uint8_t, uint32_t
+#include <mutex>        // std::mutex
+#include <string_view>  // std::string_view
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+#include "ttstrset_wx.h"  // strmap -- Hashed set and map of strings with a case policy
+
+namespace tt
+{
+    enum class PATHTYPE : uint8_t
+    {
+        missing,
+        file,  // anything that exists and isn't a directory
+        directory
+    };
+}  // namespace tt
+
+namespace ttlib
+{
+    class statcache
+    {
+    public:
+        /// A ttl of zero means entries never expire -- they are only refreshed after they are
+        /// invalidated.
+        statcache(std::chrono::milliseconds ttl = std::chrono::milliseconds(0));
+
+        /// Returns the type of path, calling the file system only if the path isn't cached or the
+        /// cached entry is no longer valid.
+        tt::PATHTYPE status(std::string_view path);
+
+        bool file_exists(std::string_view path) { return status(path) == tt::PATHTYPE::file; }
+        bool dir_exists(std::string_view path) { return status(path) == tt::PATHTYPE::directory; }
+
+        /// Reads every entry in dir and caches its type. Until the listing is invalidated, any
+        /// path in dir that wasn't in the listing is known not to exist without checking the file
+        /// system. The paths in dir must use '/' as the separator for this to work. Returns false
+        /// if dir could not be read.
+        bool prime(std::string_view dir);
+
+        /// Marks every cached entry as invalid.
+        void invalidate() noexcept;
+
+        /// Marks path and the listing of its parent directory (if it was primed) as invalid. Call
+        /// this after creating or removing path.
+        void invalidate(std::string_view path);
+
+        /// Removes every entry.
+        void clear();
+
+        void set_ttl(std::chrono::milliseconds ttl) noexcept { m_ttl = ttl; }
+        std::chrono::milliseconds ttl() const noexcept { return m_ttl; }
+
+        /// Incremented every time invalidate() is called.
+        uint32_t generation() const noexcept { return m_generation; }
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        /// Returns the type of path by calling the file system. Errors are treated as the path not
+        /// existing, so this never throws.
+        static tt::PATHTYPE query(std::string_view path);
+
+        /// Installs the cache used by ttlib::file_exists() and ttlib::dir_exists(), or removes it
+        /// if cache is nullptr. The cache must remain valid until it is removed.
+        static void set_global(ttlib::statcache* cache) noexcept;
+
+        /// Returns the cache installed by set_global(), or nullptr if there isn't one.
+        static ttlib::statcache* global() noexcept;
+
+    protected:
+        struct entry
+        {
+            std::chrono::steady_clock::time_point checked;
+            uint32_t generation;
+            tt::PATHTYPE type;
+            bool listed;  // true if this is a directory whose entries have all been cached
+        };
+
+        bool is_current(const entry& item, std::chrono::steady_clock::time_point now,
+                        std::chrono::milliseconds ttl) const
+        {
+            return item.generation == m_generation && (ttl.count() == 0 || now - item.checked < ttl);
+        }
+
+        // Returns the current time if entries can expire, otherwise a default time_point.
+        std::chrono::steady_clock::time_point get_now(std::chrono::milliseconds ttl) const
+        {
+            return (ttl.count() != 0) ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        }
+
+        // generation is the value of m_generation from before the file system was called.
+        void store(std::string_view path, tt::PATHTYPE type, bool listed, std::chrono::steady_clock::time_point now,
+                   uint32_t generation);
+
+    private:
+        mutable std::mutex m_mutex;
+        ttlib::strmap<entry> m_entries;
+        std::atomic<std::chrono::milliseconds> m_ttl;
+        std::atomic<uint32_t> m_generation { 0 };
+
+        // Incremented by both invalidate() overloads. The file system is called without m_mutex
+        // locked, so a result is only stored if this hasn't changed since before the call.
+        std::atomic<uint32_t> m_changes { 0 };
+    };
+}  // namespace ttlib
@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Single-allocation string concatenation and string builder
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttstrbuilder_wx.h>
+
+using namespace ttlib;
+
+strbuilder& strbuilder::append(std::string_view str)
+{
+    while (!str.empty())
+    {
+        if (m_current >= m_chunks.size())
+        {
+            // Each new chunk is twice the size of the previous one, but never smaller than what is
+            // needed for the rest of str.
+            size_t capacity = m_chunks.empty() ? m_initial_size : m_chunks.back().capacity * 2;
+            if (capacity < str.size())
+                capacity = str.size();
+            m_chunks.push_back({ std::make_unique<char[]>(capacity), capacity, 0 });
+        }
+
+        auto& current = m_chunks[m_current];
+        auto count = std::min(current.capacity - current.used, str.size());
+        std::memcpy(current.data.get() + current.used, str.data(), count);
+        current.used += count;
+        m_size += count;
+        str.remove_prefix(count);
+
+        if (current.used == current.capacity)
+            ++m_current;
+    }
+    return *this;
+}
+
+void strbuilder::clear()
+{
+    for (auto& iter: m_chunks)
+        iter.used = 0;
+    m_current = 0;
+    m_size = 0;
+}
+
+ttlib::cstr strbuilder::finish()
+{
+    ttlib::cstr result;
+    finish(result);
+    return result;
+}
+
+void strbuilder::finish(std::string& dest)
+{
+    dest.reserve(dest.size() + m_size);
+    for (auto& iter: m_chunks)
+    {
+        if (!iter.used)
+            break;
+        dest.append(iter.data.get(), iter.used);
+    }
+    clear();
+}
@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Single-allocation string concatenation and string builder
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttstrbuilder_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::concat() joins any number of strings, views, characters and integers into a ttlib::cstr.
+/// The total length is calculated before anything is copied, so the result is allocated exactly
+/// once.
+///
+///     auto msg = ttlib::concat("File: ", filename, " Line: ", line, '\n');
+///
+/// ttlib::strbuilder is used when the pieces are not all known at once (e.g., when building a
+/// string in a loop). Text is appended to chunks that double in size as needed, so existing text
+/// is never copied while the string grows. Calling finish() copies the chunks into a ttlib::cstr
+/// with a single allocation. The chunks are kept, so a builder that is reused doesn't need to
+/// allocate again.
+
+#include <charconv>     // std::to_chars
+#include <memory>       // std::unique_ptr
+#include <string_view>  // std::string_view
+#include <type_traits>  // std::enable_if_t, std::is_integral_v, std::is_same_v
+#include <vector>
+
+#include "ttcstr_wx.h"  // cstr -- std::string with additional methods
+
+namespace ttlib
+{
+    /// Converts a single argument passed to concat() or strbuilder into a std::string_view.
+    /// Integers are converted into an internal buffer.
+    ///
+    /// Only char is added as a character. signed char, unsigned char (and therefore int8_t and
+    /// uint8_t) and the wide character types are integers, so they are added as numbers. A bool is
+    /// added as "true" or "false".
+    class concat_arg
+    {
+    public:
+        concat_arg(std::string_view str) : m_ptr(str.data()), m_len(str.size()) {}
+        concat_arg(const std::string& str) : m_ptr(str.data()), m_len(str.size()) {}
+        concat_arg(const char* psz) : m_ptr(psz ? psz : ""), m_len(psz ? std::char_traits<char>::length(psz) : 0) {}
+
+        concat_arg(char ch) : m_len(1) { m_buf[0] = ch; }
+
+        // A template so that pointers to other types don't silently convert to bool.
+        template <typename T, std::enable_if_t<std::is_same_v<T, bool>, int> = 0>
+        concat_arg(T value) : m_ptr(value ? "true" : "false"), m_len(value ? 4 : 5) {}
+
+        template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> &&
+                                                   !std::is_same_v<T, bool>,
+                                               int> = 0>
+        concat_arg(T value)
+        {
+            auto result = std::to_chars(m_buf, m_buf + sizeof(m_buf), value);
+            m_len = static_cast<size_t>(result.ptr - m_buf);
+        }
+
+        std::string_view view() const { return m_ptr ? std::string_view(m_ptr, m_len) : std::string_view(m_buf, m_len); }
+
+    private:
+        const char* m_ptr { nullptr };
+        size_t m_len;
+        char m_buf[24];  // large enough for any 64-bit integer including the sign
+    };
+
+    /// Returns a ttlib::cstr containing all of the arguments. Arguments can be any type that
+    /// converts to std::string_view, a char, an integer, or a bool.
+    template <typename... Args>
+    ttlib::cstr concat(const Args&... args)
+    {
+        static_assert(sizeof...(Args) > 0, "concat() requires at least one argument");
+
+        const concat_arg parts[] = { concat_arg(args)... };
+
+        size_t total = 0;
+        for (auto& part: parts)
+            total += part.view().size();
+
+        ttlib::cstr result;
+        result.reserve(total);
+        for (auto& part: parts)
+            result.append(part.view());
+        return result;
+    }
+
+    /// Appends text to chunks that grow geometrically, and then copies everything into a
+    /// ttlib::cstr with a single allocation when finish() is called.
+    class strbuilder
+    {
+    public:
+        /// initial_size is the capacity of the first chunk.
+        strbuilder(size_t initial_size = 256) : m_initial_size(initial_size ? initial_size : 256) {}
+
+        strbuilder& append(std::string_view str);
+
+        strbuilder& operator<<(const concat_arg& arg) { return append(arg.view()); }
+
+        /// Returns the total number of characters that have been appended.
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        /// Removes all text, but keeps the chunks so that they can be reused.
+        void clear();
+
+        /// Returns all of the appended text and then calls clear().
+        ttlib::cstr finish();
+
+        /// Appends all of the text to dest and then calls clear().
+        void finish(std::string& dest);
+
+    private:
+        struct chunk
+        {
+            std::unique_ptr<char[]> data;
+            size_t capacity;
+            size_t used;
+        };
+
+        std::vector<chunk> m_chunks;
+        size_t m_current { 0 };  // index of the chunk currently being appended to
+        size_t m_size { 0 };
+        size_t m_initial_size;
+    };
+}  // namespace ttlib
@@ -0,0 +1,217 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Hash index of the strings in a vector
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttstrindex_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::strindex is the index used by ttlib::strset and ttlib::strmap. It maps each string in a
+/// vector owned by the caller to the position of the first string that is the same using the
+/// index's CASE policy. The vector can hold anything that a string can be taken from -- every
+/// function that needs to read the vector takes a key function that returns the string of an
+/// element:
+///
+///     auto key = [](const std::pair<ttlib::cstr, int>& entry) -> std::string_view { return entry.first; };
+///     index.erase(entries, pos, pos + 1, key);
+///     entries.erase(entries.begin() + pos);
+///
+/// The owner must call add() after appending a string and erase() before removing strings. The
+/// index can't detect any other change to the vector, so it should only be used by a class that
+/// controls every change to its vector.
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+namespace ttlib
+{
+    class strindex
+    {
+    public:
+        /// CASE::utf8 folds the same as CASE::either, so both create an index that ignores ASCII case.
+        strindex(tt::CASE checkcase = tt::CASE::exact) : m_ignore_case(checkcase != tt::CASE::exact) {}
+
+        bool ignores_case() const { return m_ignore_case; }
+
+        /// Returns the position of the first string at or after start that is the same as str, or
+        /// tt::npos if there isn't one.
+        ///
+        /// If checkcase is CASE::exact, or the index ignores case, the index is used and only
+        /// the strings it points to are compared. Otherwise every string from start on is compared.
+        template <class T, class Key>
+        size_t find(const std::vector<T>& items, Key key, std::string_view str, tt::CASE checkcase,
+                    size_t start = 0) const
+        {
+            if (checkcase == tt::CASE::exact || m_ignore_case)
+            {
+                auto pos = m_ignore_case ? lookup(m_either, str) : lookup(m_exact, str);
+                if (pos == tt::npos)
+                    return tt::npos;
+
+                // An index that ignores case may point to a string that is only the same when case
+                // is ignored, so the string is compared again using checkcase.
+                if (pos >= start && pos < items.size() && ttlib::is_sameas(key(items[pos]), str, checkcase))
+                    return pos;
+
+                // Any other match has to come after the first string the index found, so only the
+                // strings after it need to be compared.
+                if (pos >= start)
+                    start = pos + 1;
+            }
+
+            for (; start < items.size(); ++start)
+            {
+                if (ttlib::is_sameas(key(items[start]), str, checkcase))
+                    return start;
+            }
+            return tt::npos;
+        }
+
+        /// Call after adding str at pos. If the index already has a string that is the same as
+        /// str, the earlier position is kept.
+        void add(std::string_view str, size_t pos)
+        {
+            if (m_ignore_case)
+                add(m_either, str, pos);
+            else
+                add(m_exact, str, pos);
+        }
+
+        /// Call before removing the strings from first up to (but not including) last. Only the
+        /// removed strings are looked up, and only the positions after them are changed.
+        template <class T, class Key>
+        void erase(const std::vector<T>& items, size_t first, size_t last, Key key)
+        {
+            if (m_ignore_case)
+                erase(m_either, items, first, last, key);
+            else
+                erase(m_exact, items, first, last, key);
+        }
+
+        /// Replaces the index with the strings in items.
+        template <class T, class Key>
+        void rebuild(const std::vector<T>& items, Key key)
+        {
+            clear();
+            reserve(items.size());
+            for (size_t pos = 0; pos < items.size(); ++pos)
+                add(key(items[pos]), pos);
+        }
+
+        void clear()
+        {
+            m_exact.clear();
+            m_either.clear();
+            m_duplicates = false;
+        }
+
+        void reserve(size_t count)
+        {
+            if (m_ignore_case)
+                m_either.reserve(count);
+            else
+                m_exact.reserve(count);
+        }
+
+    protected:
+        template <class Map>
+        static auto find_entry(Map& map, std::string_view str)
+        {
+#if defined(__cpp_lib_generic_unordered_lookup)
+            return map.find(str);
+#else
+            // Before C++20, unordered_map::find() only accepts the key type. Reusing the same
+            // string means it only allocates when a longer string is looked up.
+            thread_local std::string key;
+            key.assign(str);
+            return map.find(key);
+#endif
+        }
+
+        template <class Map>
+        static size_t lookup(const Map& map, std::string_view str)
+        {
+            auto iter = find_entry(map, str);
+            return (iter != map.end()) ? iter->second : tt::npos;
+        }
+
+        template <class Map>
+        void add(Map& map, std::string_view str, size_t pos)
+        {
+            if (find_entry(map, str) == map.end())
+                map.emplace(str, pos);
+            else
+                m_duplicates = true;
+        }
+
+        template <class Map, class T, class Key>
+        void erase(Map& map, const std::vector<T>& items, size_t first, size_t last, Key key)
+        {
+            if (last > items.size())
+                last = items.size();
+            if (first >= last)
+                return;
+            const auto count = last - first;
+
+            // Only the removed strings are looked up. If the index has never had a duplicate, their
+            // entries can simply be erased.
+            std::vector<typename Map::iterator> removed;
+            for (auto pos = first; pos < last; ++pos)
+            {
+                if (auto iter = find_entry(map, key(items[pos])); iter != map.end() && iter->second == pos)
+                {
+                    if (m_duplicates)
+                    {
+                        iter->second = tt::npos;
+                        removed.emplace_back(iter);
+                    }
+                    else
+                    {
+                        map.erase(iter);
+                    }
+                }
+            }
+
+            // Otherwise the first copy of a removed string that comes after the removed ones
+            // replaces it.
+            if (removed.size())
+            {
+                for (auto pos = last; pos < items.size(); ++pos)
+                {
+                    if (auto iter = find_entry(map, key(items[pos])); iter != map.end() && iter->second == tt::npos)
+                        iter->second = pos;
+                }
+                for (auto& iter: removed)
+                {
+                    if (iter->second == tt::npos)
+                        map.erase(iter);
+                }
+            }
+
+            // Walking the entries is much faster than hashing every string after the removed ones
+            // to find its entry.
+            for (auto& entry: map)
+            {
+                if (entry.second >= last)
+                    entry.second -= count;
+            }
+        }
+
+    private:
+        std::unordered_map<std::string, size_t, ttlib::str_hash, ttlib::str_equal> m_exact;
+        std::unordered_map<std::string, size_t, ttlib::str_hashi, ttlib::str_equali> m_either;
+        bool m_ignore_case;
+        bool m_duplicates { false };  // true if add() was ever called with a string already in the index
+    };
+}  // namespace ttlib
@@ -5,41 +5,42 @@
 // License:   Apache License -- see ../../LICENSE
 /////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cwctype>
 #include <filesystem>
 
 #if defined(_WIN32)
     #include <cwchar>
-    #include <cwctype>
 #else
     #include <cstring>
 #endif
 
-#include <wx/filename.h>
-
 #include <ttlib_wx.h>  // ttlib namespace functions and declarations
 #include <ttstring_wx.h>
 
-#include <ttcstr_wx.h>  // cstr -- std::string with additional methods
+#include <ttcstr_wx.h>      // cstr -- std::string with additional methods
+#include <ttfindfile_wx.h>  // findfile -- Parallel search of a directory tree for files by name or pattern
+#include <ttpath_wx.h>      // Lexical path operations that don't access the file system
+#include <ttsview_wx.h>     // sview -- std::string_view with additional methods
+#include <ttutf8_wx.h>      // UTF-8 code point decoding, iteration, counting and indexing
 
 std::string ttString::sub_cstr(size_type pos, size_type count) const
 {
     ttlib::cstr str;
-    if (pos == 0 && count == tt::npos)
-    {
+    if (pos >= size())
+        return std::move(str);
+
+    // Only the requested characters are converted.
+    count = std::min(count, size() - pos);
 #if defined(_WIN32)
-        utf16to8(wx_str(), str);
+    ttlib::utf16to8(std::wstring_view(wx_str() + pos, count), str);
 #else
-        str = *this;
+    if (pos == 0 && count == size())
+        str.assign_wx(*this);
+    else
+        str.assign_wx(Mid(pos, count));
 #endif  // _WIN32
-    }
-    else if (pos < size())
-    {
-        // wxString tmp(*this, pos, size() - pos);
-
-        // On Windows, this will convert to UTF8, otherwise it's a straight copy of tmp
-        str.assign_wx(Mid(pos, size() - pos));
-    }
-    return str;
+    return std::move(str);
 }
 
 ttString& ttString::append_view(std::string_view str, size_t posStart, size_t len)
@@ -81,89 +82,124 @@ ttString& ttString::assign_view(std::string_view str, size_t posStart, size_t le
     return *this;
 }
 
-int ttString::comparei(std::string_view str) const
-{
-    ttString tmp(str);
-    return CmpNoCase(tmp);
-}
+// The following functions compare wxString's internal storage directly against a UTF8 string
+// rather than converting the UTF8 string into a temporary wxString. ASCII characters are
+// compared without decoding, so there is no conversion or allocation at all in the common case.
 
-size_t ttString::locate(std::string_view vstr, size_t posStart, tt::CASE checkcase) const
+namespace
 {
-    if (vstr.empty() || posStart >= size())
-        return npos;
-
-    ttString str(vstr);
-
-    if (checkcase == tt::CASE::exact)
-        return find(str, posStart);
-
-#if defined(_WIN32)
-    // Note that we don't support tt::CASE::utf8 under windows
-
-    auto chLower = std::towlower(str[0]);
-    for (auto pos = posStart; pos < length(); ++pos)
+#if !wxUSE_UNICODE_UTF8
+    // Returns the code point at ptr and advances ptr past it.
+    inline char32_t next_wide(const wxStringCharType*& ptr, const wxStringCharType* end) noexcept
     {
-        if (std::towlower(at(pos)) == chLower)
+        auto ch = static_cast<char32_t>(*ptr++);
+        if constexpr (sizeof(wxStringCharType) == 2)
         {
-            size_t posSub;
-            for (posSub = 1; posSub < str.length(); ++posSub)
-            {
-                if (pos + posSub >= length())
-                    return npos;
-                if (std::towlower(at(pos + posSub)) != std::towlower(str.at(posSub)))
-                    break;
-            }
-            if (posSub >= str.length())
-                return pos;
+            if (ch >= 0xD800 && ch <= 0xDBFF && ptr < end && *ptr >= 0xDC00 && *ptr <= 0xDFFF)
+                ch = 0x10000 + ((ch - 0xD800) << 10) + (static_cast<char32_t>(*ptr++) - 0xDC00);
         }
+        return ch;
     }
 
-#else
-    if (checkcase == tt::CASE::either)
+    inline char32_t fold_case(char32_t ch) noexcept
     {
-        auto chLower = std::tolower(str[0]);
-        for (auto pos = posStart; pos < length(); ++pos)
-        {
-            if (std::tolower(at(pos)) == chLower)
-            {
-                size_t posSub;
-                for (posSub = 1; posSub < str.length(); ++posSub)
-                {
-                    if (pos + posSub >= length())
-                        return npos;
-                    if (std::tolower(at(pos + posSub)) != std::tolower(str.at(posSub)))
-                        break;
-                }
-                if (posSub >= str.length())
-                    return pos;
-            }
-        }
+        if (ch < 0x80)
+            return (ch >= 'A' && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+        return static_cast<char32_t>(std::towlower(static_cast<wint_t>(ch)));
     }
-    else
+
+    // Compares str against the beginning of [ptr, end). Returns 0 if all of str matches, in
+    // which case ptr is advanced past the matching characters. Otherwise returns a negative
+    // value if the wide string is less than str, or a positive value if it is greater.
+    int compare_prefix(const wxStringCharType*& ptr, const wxStringCharType* end, std::string_view str,
+                       bool ignore_case) noexcept
     {
-        auto utf8locale = std::locale("en_US.utf8");
-        auto chLower = std::tolower(str[0], utf8locale);
-        for (auto pos = posStart; pos < length(); ++pos)
+        size_t pos = 0;
+        while (pos < str.size())
         {
-            if (std::tolower(at(pos), utf8locale) == chLower)
+            if (ptr >= end)
+                return -1;
+
+            char32_t wide_ch;
+            char32_t utf8_ch;
+            auto byte = static_cast<unsigned char>(str[pos]);
+            if (static_cast<char32_t>(*ptr) < 0x80 && byte < 0x80)
+            {
+                wide_ch = static_cast<char32_t>(*ptr++);
+                utf8_ch = byte;
+                ++pos;
+            }
+            else
+            {
+                wide_ch = next_wide(ptr, end);
+                bool valid = true;
+                pos += ttlib::decode_utf8(str.data() + pos, str.size() - pos, utf8_ch, valid);
+            }
+
+            if (wide_ch != utf8_ch)
             {
-                size_t posSub;
-                for (posSub = 1; posSub < str.length(); ++posSub)
+                if (ignore_case)
                 {
-                    if (pos + posSub >= length())
-                        return npos;
-                    if (std::tolower(at(pos + posSub), utf8locale) != std::tolower(str.at(posSub), utf8locale))
-                        break;
+                    wide_ch = fold_case(wide_ch);
+                    utf8_ch = fold_case(utf8_ch);
                 }
-                if (posSub >= str.length())
-                    return pos;
+                if (wide_ch != utf8_ch)
+                    return (wide_ch < utf8_ch) ? -1 : 1;
             }
         }
+        return 0;
     }
+#endif  // !wxUSE_UNICODE_UTF8
+}  // anonymous namespace
 
-#endif  // _WIN32
+int ttString::comparei(std::string_view str) const
+{
+#if wxUSE_UNICODE_UTF8
+    return ttlib::sview(wx_str(), std::char_traits<char>::length(wx_str())).comparei(str);
+#else
+    auto ptr = wx_str();
+    auto end = ptr + length();
+    if (auto result = compare_prefix(ptr, end, str, true); result != 0)
+        return result;
+    return (ptr < end) ? 1 : 0;
+#endif  // wxUSE_UNICODE_UTF8
+}
+
+size_t ttString::locate(std::string_view vstr, size_t posStart, tt::CASE checkcase) const
+{
+    if (vstr.empty() || posStart >= size())
+        return npos;
+
+#if wxUSE_UNICODE_UTF8
+    // wxString positions are in characters, so they need to be converted to and from byte offsets.
+    ttlib::sview bytes(wx_str(), std::char_traits<char>::length(wx_str()));
+    auto found = bytes.locate(vstr, ttlib::utf8_offset_of(bytes, posStart), checkcase);
+    return (found == tt::npos) ? npos : ttlib::utf8_length(bytes.substr(0, found));
+#else
+    const bool ignore_case = (checkcase != tt::CASE::exact);
+    const auto data = wx_str();
+    const auto end = data + length();
+
+    // If the first character is ASCII, it can be used to skip positions without calling
+    // compare_prefix().
+    const auto first = static_cast<unsigned char>(vstr[0]);
+    const auto first_folded = fold_case(first);
+
+    for (auto pos = posStart; pos < length(); ++pos)
+    {
+        if (first < 0x80)
+        {
+            auto ch = static_cast<char32_t>(data[pos]);
+            if (ch != first && (!ignore_case || fold_case(ch) != first_folded))
+                continue;
+        }
 
+        auto ptr = data + pos;
+        if (compare_prefix(ptr, end, vstr, ignore_case) == 0)
+            return pos;
+    }
     return npos;
+#endif  // wxUSE_UNICODE_UTF8
 }
 
 size_t ttString::locate_wx(const wxString& str, size_t posStart, tt::CASE checkcase) const
@@ -290,8 +326,13 @@ size_t ttString::stepover(size_t start) const
 
 bool ttString::is_sameas(std::string_view str, tt::CASE checkcase) const
 {
-    ttString tmp(str);
-    return IsSameAs(tmp, checkcase == tt::CASE::exact);
+#if wxUSE_UNICODE_UTF8
+    return ttlib::sview(wx_str(), std::char_traits<char>::length(wx_str())).is_sameas(str, checkcase);
+#else
+    auto ptr = wx_str();
+    auto end = ptr + length();
+    return (compare_prefix(ptr, end, str, checkcase != tt::CASE::exact) == 0 && ptr == end);
+#endif  // wxUSE_UNICODE_UTF8
 }
 
 bool ttString::is_sameprefix(std::string_view vstr, tt::CASE checkcase) const
@@ -299,42 +340,12 @@ bool ttString::is_sameprefix(std::string_view vstr, tt::CASE checkcase) const
     if (vstr.empty())
         return empty();
 
-    if (empty() || size() < vstr.size())
-        return false;
-
-#if defined(_WIN32)
-    auto str = ttlib::utf8to16(vstr);
-#else
-    std::string str(vstr);
-#endif  // _WIN32
-
-    if (checkcase == tt::CASE::exact)
-    {
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (*iterMain++ != iterSub)
-                return false;
-        }
-        return true;
-    }
-    else
-    {
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-#if defined(_WIN32)
-            if (std::towlower(*iterMain++) != std::towlower(iterSub))
-                return false;
+#if wxUSE_UNICODE_UTF8
+    return ttlib::sview(wx_str(), std::char_traits<char>::length(wx_str())).is_sameprefix(vstr, checkcase);
 #else
-            if (std::tolower(*iterMain++) != std::tolower(iterSub))
-                return false;
-#endif
-        }
-        return true;
-    }
-
-    return false;
+    auto ptr = wx_str();
+    return (compare_prefix(ptr, ptr + length(), vstr, checkcase != tt::CASE::exact) == 0);
+#endif  // wxUSE_UNICODE_UTF8
 }
 
 bool ttString::is_sameprefix_wx(const wxString& str, tt::CASE checkcase) const
@@ -709,32 +720,38 @@ ttString& ttString::append_filename_wx(const wxString& filename)
 
 ttString& ttString::make_absolute()
 {
-    wxFileName file(*this);
-    file.MakeAbsolute();
+    if (empty())
+        return *this;
 
-    assign(file.GetFullPath());
+    thread_local std::string result;
+    ttlib::path_absolute(sub_cstr(), result);
+    assign_view(result);
     return *this;
 }
 
 ttString& ttString::make_relative_wx(const wxString& pathBase)
 {
-    wxFileName file(*this);
-    file.MakeRelativeTo(pathBase);
-
-    assign(file.GetFullPath());
-    return *this;
+    return make_relative(ttString(pathBase).sub_cstr());
 }
 
 ttString& ttString::make_relative(std::string_view pathBase)
 {
-    wxFileName file(*this);
-#if defined(_WIN32)
-    file.MakeRelativeTo(ttlib::utf8to16(pathBase));
-#else
-    file.MakeRelativeTo(std::string(pathBase));
-#endif  // _WIN32
+    if (empty())
+        return *this;
 
-    assign(file.GetFullPath());
+    // Same as cstr::make_relative(), only the result is converted back into a wxString.
+    auto path = sub_cstr();
+    thread_local std::string result;
+    if (!ttlib::path_relative(path, pathBase, result))
+    {
+        thread_local std::string abs_path;
+        thread_local std::string abs_base;
+        ttlib::path_absolute(path, abs_path);
+        ttlib::path_absolute(pathBase, abs_base);
+        if (!ttlib::path_relative(abs_path, abs_base, result))
+            result = abs_path;
+    }
+    assign_view(result);
     return *this;
 }
 
@@ -775,19 +792,16 @@ bool ttString::ChangeDir(bool is_dir) const
 
 ttString ttString::find_file(const ttString& dir, const ttString& filename)
 {
-    auto dir_iterator = std::filesystem::recursive_directory_iterator(dir.wx_str());
-    for (auto& entry: dir_iterator)
-    {
-        if (entry.is_regular_file())
-        {
-            if (entry.path().filename() == filename.wx_str())
-            {
-                return entry.path().string();
-            }
-        }
-    }
-
-    return wxEmptyString;
+    // A single thread that stops at the first match reads the directories in the same order every
+    // time, so the same file is returned for the same tree.
+    ttlib::findfile finder(tt::CASE::exact);
+    finder.add_name(filename.sub_cstr());
+    finder.set_threads(1);
+    finder.set_max_matches(1);
+    auto results = finder.search(dir.sub_cstr());
+    if (results.empty())
+        return wxEmptyString;
+    return ttString(results[0]);
 }
 
 std::string ttString::sub_find_nonspace(size_t start) const { return sub_cstr(find_nonspace(start)); }
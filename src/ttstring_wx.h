@@ -65,7 +65,8 @@ public:
     ttString(std::string_view str) { this->assign(str.data(), str.size()); }
 #endif  // _WIN32
 
-    /// On Windows, converts to UTF8 before creating a ttlib::cstr copy.
+    /// Returns a UTF8 copy of count characters starting at pos. On Windows, only those
+    /// characters are converted.
     std::string sub_cstr(size_type pos = 0, size_type count = tt::npos) const;
 
     ttString& append_view(std::string_view str, size_t posStart = 0, size_t len = npos);
@@ -171,7 +172,8 @@ public:
 
     /// Returns true if the strings are identical.
     ///
-    /// On Windows, the string will first be converted to UTF16 before comparing.
+    /// str is compared directly against the wide characters without creating a temporary
+    /// wxString.
     bool is_sameas(std::string_view str, tt::CASE checkcase = tt::CASE::exact) const;
 
     bool is_sameas_wx(const wxString& str, tt::CASE checkcase = tt::CASE::exact) const
@@ -295,7 +297,7 @@ public:
         return *this;
     };
 
-    /// Changes any current path to an absolute path.
+    /// Changes any current path to a normalized absolute path that uses '/' as the separator.
     ttString& make_absolute();
 
     /// Returns the file name which can be used to access this file if the current directory is pathBase
@@ -305,10 +307,10 @@ public:
     ttString& make_relative(std::string_view pathBase);
 
     /// Returns true if the current string refers to an existing file.
-    bool file_exists() const { return wxFileExists(*this); };
+    bool file_exists() const { return ttlib::file_exists(sub_cstr()); };
 
     /// Returns true if the current string refers to an existing directory.
-    bool dir_exists() const { return wxDirExists(*this); };
+    bool dir_exists() const { return ttlib::dir_exists(sub_cstr()); };
 
     /// Confirms current string is an existing directory and then changes to that directory.
     ///
@@ -318,7 +320,10 @@ public:
 
     // This will return a full path to the file if found, or an empty string if not found.
     //
-    // All subdirectories of the specified directory will be searched.
+    // All subdirectories of the specified directory will be searched, and only a regular file
+    // whose name matches the case of filename is returned. The path uses '/' to separate
+    // directories. Use ttlib::findfile (ttfindfile_wx.h) to search for more than one file or for
+    // wildcard patterns.
     static ttString find_file(const ttString& dir, const ttString& filename);
 
     ///////////////////// std::string functions ///////////////////////////
@@ -348,3 +353,19 @@ public:
     ttSaveCwd() { assignCwd(); }
     ~ttSaveCwd() { ChangeDir(); }
 };
+
+// Allows ttString to be used as a key in std::unordered_map and std::unordered_set. The hash is
+// generated from wxString's internal storage, so no conversion to UTF8 is performed.
+template <>
+struct std::hash<ttString>
+{
+    size_t operator()(const ttString& str) const noexcept
+    {
+#if wxUSE_UNICODE_UTF8
+        std::string_view bytes(str.wx_str(), std::char_traits<char>::length(str.wx_str()));
+#else
+        std::string_view bytes(reinterpret_cast<const char*>(str.wx_str()), str.length() * sizeof(wxStringCharType));
+#endif
+        return static_cast<size_t>(ttlib::get_hash(bytes));
+    }
+};
@@ -0,0 +1,145 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Contiguous table of strings stored in a single buffer
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <numeric>    // std::iota
+#include <stdexcept>  // std::out_of_range, std::length_error
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttstringtable_wx.h>
+
+using namespace ttlib;
+
+namespace
+{
+    inline unsigned char fold(char ch) noexcept
+    {
+        auto uch = static_cast<unsigned char>(ch);
+        return (uch >= 'A' && uch <= 'Z') ? static_cast<unsigned char>(uch + ('a' - 'A')) : uch;
+    }
+
+    // Returns true if str1 sorts before str2 ignoring ASCII case.
+    bool less_folded(std::string_view str1, std::string_view str2) noexcept
+    {
+        auto len = std::min(str1.size(), str2.size());
+        for (size_t pos = 0; pos < len; ++pos)
+        {
+            auto ch1 = fold(str1[pos]);
+            auto ch2 = fold(str2[pos]);
+            if (ch1 != ch2)
+                return ch1 < ch2;
+        }
+        return str1.size() < str2.size();
+    }
+}  // anonymous namespace
+
+void stringtable::assign(const std::vector<ttlib::cstr>& strings)
+{
+    size_t chars = 0;
+    for (auto& iter: strings)
+        chars += iter.size();
+
+    clear();
+    reserve(strings.size(), chars);
+    for (auto& iter: strings)
+        push_back(iter);
+}
+
+ttlib::multistr stringtable::to_multistr() const
+{
+    ttlib::multistr result;
+    result.reserve(size());
+    for (size_t pos = 0; pos < size(); ++pos)
+        result.emplace_back((*this)[pos]);
+    return result;
+}
+
+void stringtable::push_back(std::string_view str)
+{
+    // Offsets are 32-bit, so a string that would end past 4GB can't be stored.
+    if (str.size() > UINT32_MAX - m_pool.size())
+        throw std::length_error("ttlib::stringtable is limited to 4GB of characters");
+    if (m_sorted && !empty() && std::string_view(back()).compare(str) > 0)
+        m_sorted = false;
+    m_pool.append(str);
+    m_offsets.push_back(static_cast<uint32_t>(m_pool.size()));
+}
+
+void stringtable::pop_back()
+{
+    if (empty())
+        return;
+    m_offsets.pop_back();
+    m_pool.resize(m_offsets.back());
+}
+
+ttlib::sview stringtable::at(size_t pos) const
+{
+    if (pos >= size())
+        throw std::out_of_range("ttlib::stringtable::at() position is out of range");
+    return (*this)[pos];
+}
+
+void stringtable::sort(tt::CASE checkcase)
+{
+    std::vector<uint32_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    if (checkcase == tt::CASE::exact)
+    {
+        std::sort(order.begin(), order.end(),
+                  [this](uint32_t left, uint32_t right)
+                  { return std::string_view((*this)[left]) < std::string_view((*this)[right]); });
+    }
+    else
+    {
+        std::stable_sort(order.begin(), order.end(),
+                         [this](uint32_t left, uint32_t right) { return less_folded((*this)[left], (*this)[right]); });
+    }
+
+    // Rebuild the pool in the new order so that iterating remains sequential.
+    std::string pool;
+    pool.reserve(m_pool.size());
+    std::vector<uint32_t> offsets;
+    offsets.reserve(m_offsets.size());
+    offsets.push_back(0);
+    for (auto pos: order)
+    {
+        pool.append((*this)[pos]);
+        offsets.push_back(static_cast<uint32_t>(pool.size()));
+    }
+    m_pool.swap(pool);
+    m_offsets.swap(offsets);
+
+    m_sorted = (checkcase == tt::CASE::exact);
+}
+
+size_t stringtable::find(std::string_view str, tt::CASE checkcase) const
+{
+    if (m_sorted && checkcase == tt::CASE::exact)
+    {
+        size_t low = 0;
+        size_t high = size();
+        while (low < high)
+        {
+            auto mid = low + (high - low) / 2;
+            if (std::string_view((*this)[mid]) < str)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return (low < size() && std::string_view((*this)[low]) == str) ? low : tt::npos;
+    }
+
+    for (size_t pos = 0; pos < size(); ++pos)
+    {
+        auto entry = (*this)[pos];
+        if (entry.size() == str.size() && ttlib::is_sameas(entry, str, checkcase))
+            return pos;
+    }
+    return tt::npos;
+}
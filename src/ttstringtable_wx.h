@@ -0,0 +1,138 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Contiguous table of strings stored in a single buffer
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttstringtable_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::stringtable is an alternative to ttlib::multistr and ttlib::cstrVector for large lists of
+/// strings that are rarely modified once added. Instead of a separate std::string for each entry,
+/// all of the characters are stored in a single buffer and each entry is just a 32-bit offset into
+/// that buffer. Entries are returned as ttlib::sview, and are not zero-terminated.
+///
+/// Because the strings are contiguous, iterating through the table reads memory sequentially, and
+/// a table of short strings needs roughly half the memory of a vector of std::string.
+///
+/// The total number of characters in a table is limited to 4GB -- push_back() throws
+/// std::length_error rather than exceed it.
+
+#include <cstdint>      // uint32_t
+#include <iterator>     // std::forward_iterator_tag
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>
+
+#include "ttlib_wx.h"       // ttlib namespace functions and declarations
+#include "ttmultistr_wx.h"  // multistr -- Breaks a single string into multiple strings
+#include "ttsview_wx.h"     // sview -- std::string_view with additional methods
+
+namespace ttlib
+{
+    class stringtable
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ttlib::sview;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ttlib::sview*;
+            using reference = ttlib::sview;
+
+            const_iterator(const stringtable* table, size_t pos) : m_table(table), m_pos(pos) {}
+
+            ttlib::sview operator*() const { return (*m_table)[m_pos]; }
+
+            const_iterator& operator++()
+            {
+                ++m_pos;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                auto prev = *this;
+                ++m_pos;
+                return prev;
+            }
+
+            bool operator==(const const_iterator& other) const { return m_pos == other.m_pos; }
+            bool operator!=(const const_iterator& other) const { return m_pos != other.m_pos; }
+
+        private:
+            const stringtable* m_table;
+            size_t m_pos;
+        };
+
+        stringtable() = default;
+
+        /// Copies every string in strings (e.g., a ttlib::multistr or ttlib::cstrVector).
+        stringtable(const std::vector<ttlib::cstr>& strings) { assign(strings); }
+
+        /// Replaces the current contents with a copy of every string in strings.
+        void assign(const std::vector<ttlib::cstr>& strings);
+
+        /// Returns a ttlib::multistr containing a copy of every string in the table.
+        ttlib::multistr to_multistr() const;
+
+        /// Reserves room for count strings containing a total of chars characters.
+        void reserve(size_t count, size_t chars)
+        {
+            m_offsets.reserve(count + 1);
+            m_pool.reserve(chars);
+        }
+
+        /// Throws std::length_error if the table would contain more than 4GB of characters.
+        void push_back(std::string_view str);
+
+        void pop_back();
+
+        void clear()
+        {
+            m_pool.clear();
+            m_offsets.resize(1);
+            m_sorted = true;
+        }
+
+        size_t size() const { return m_offsets.size() - 1; }
+        bool empty() const { return m_offsets.size() == 1; }
+
+        /// Returns the total number of characters in all of the strings.
+        size_t pool_size() const { return m_pool.size(); }
+
+        ttlib::sview operator[](size_t pos) const
+        {
+            return ttlib::sview(m_pool.data() + m_offsets[pos], m_offsets[pos + 1] - m_offsets[pos]);
+        }
+
+        /// Throws std::out_of_range if pos is not a valid position.
+        ttlib::sview at(size_t pos) const;
+
+        ttlib::sview front() const { return (*this)[0]; }
+        ttlib::sview back() const { return (*this)[size() - 1]; }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        /// Sorts the strings. After sorting with CASE::exact, find() uses a binary search until
+        /// another string is added.
+        void sort(tt::CASE checkcase = tt::CASE::exact);
+
+        /// Returns the position of the first string identical to str, or tt::npos if not found.
+        size_t find(std::string_view str, tt::CASE checkcase = tt::CASE::exact) const;
+
+    private:
+        std::string m_pool;                     // all characters of all strings
+        std::vector<uint32_t> m_offsets { 0 };  // string n is m_pool[m_offsets[n], m_offsets[n + 1])
+        bool m_sorted { true };                 // true if sorted with CASE::exact
+    };
+}  // namespace ttlib
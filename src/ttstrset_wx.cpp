@@ -0,0 +1,44 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Hashed set and map of strings with a case policy
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttstrset_wx.h>
+
+using namespace ttlib;
+
+bool strset::insert(std::string_view str)
+{
+    if (find(str, m_case) != tt::npos)
+        return false;
+    emplace_back(str);
+    return true;
+}
+
+const ttlib::cstr& strset::append(std::string_view str)
+{
+    if (auto pos = find(str, m_case); pos != tt::npos)
+        return m_strings[pos];
+    return emplace_back(str);
+}
+
+ttlib::cstr& strset::emplace_back(std::string_view str)
+{
+    m_index.add(str, m_strings.size());
+    return m_strings.emplace_back(str);
+}
+
+bool strset::erase(std::string_view str)
+{
+    auto pos = find(str, m_case);
+    if (pos == tt::npos)
+        return false;
+
+    m_index.erase(m_strings, pos, pos + 1, entry_key);
+    m_strings.erase(m_strings.begin() + pos);
+    return true;
+}
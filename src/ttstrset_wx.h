@@ -0,0 +1,262 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   Hashed set and map of strings with a case policy
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttstrset_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::strset and ttlib::strmap replace the pattern of calling ttlib::has_member() or
+/// ttlib::add_if() on a std::vector, which compares every string in the vector on every call.
+/// Both classes keep their strings in the order they were added (so they can still be iterated
+/// like a vector), along with a hash index so that a lookup only compares strings with the same
+/// hash. Lookups take a std::string_view, so searching never constructs a temporary string.
+///
+/// The CASE policy passed to the constructor determines which strings are considered duplicates:
+///
+///     ttlib::strset includes(tt::CASE::either);
+///     for (auto& path: paths)
+///         includes.insert(path);  // "Src/" and "src/" are only added once
+///
+/// has_member(), has_filename(), add_if() and find_member() have overloads for both classes. The
+/// add_if() overloads always use the CASE policy of the set or map.
+
+#include <string_view>
+#include <utility>  // std::pair, std::move
+#include <vector>
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+#include "ttcstr_wx.h"      // cstr -- std::string with additional methods
+#include "ttstrindex_wx.h"  // strindex -- Hash index of the strings in a vector
+
+namespace ttlib
+{
+    class strset
+    {
+    public:
+        strset(tt::CASE checkcase = tt::CASE::exact) : m_index(checkcase), m_case(checkcase) {}
+
+        /// Adds str unless the set already contains it using the set's CASE policy. Returns true
+        /// if the string was added.
+        bool insert(std::string_view str);
+
+        /// Same as insert(), but returns the string in the set -- either the one that was added,
+        /// or the one that was already there. This replaces cstrVector::append() and
+        /// cstrVector::addfilename() for a set created with the appropriate CASE policy.
+        const ttlib::cstr& append(std::string_view str);
+
+        /// Adds str even if the set already contains it.
+        ttlib::cstr& emplace_back(std::string_view str);
+
+        /// Removes str if found using the set's CASE policy. Returns true if the string was
+        /// removed. Only the positions of the strings after the removed one are updated.
+        bool erase(std::string_view str);
+
+        /// Returns the position of str, or tt::npos if not found.
+        ///
+        /// If checkcase is CASE::exact, or if the set was created with CASE::either or CASE::utf8,
+        /// the hash index is used. Otherwise every string is compared.
+        size_t find(std::string_view str, tt::CASE checkcase) const
+        {
+            return m_index.find(m_strings, entry_key, str, checkcase);
+        }
+
+        /// Returns the position of str using the set's CASE policy, or tt::npos if not found.
+        size_t find(std::string_view str) const { return find(str, m_case); }
+
+        bool contains(std::string_view str) const { return find(str, m_case) != tt::npos; }
+        bool contains(std::string_view str, tt::CASE checkcase) const { return find(str, checkcase) != tt::npos; }
+
+        void clear()
+        {
+            m_strings.clear();
+            m_index.clear();
+        }
+
+        void reserve(size_t count)
+        {
+            m_strings.reserve(count);
+            m_index.reserve(count);
+        }
+
+        size_t size() const { return m_strings.size(); }
+        bool empty() const { return m_strings.empty(); }
+
+        /// Strings are in the order they were added.
+        const ttlib::cstr& operator[](size_t pos) const { return m_strings[pos]; }
+        auto begin() const { return m_strings.begin(); }
+        auto end() const { return m_strings.end(); }
+
+        /// Returns the strings in the order they were added.
+        const std::vector<ttlib::cstr>& strings() const { return m_strings; }
+
+        tt::CASE case_policy() const { return m_case; }
+
+    protected:
+        static std::string_view entry_key(const ttlib::cstr& str) { return str; }
+
+    private:
+        std::vector<ttlib::cstr> m_strings;
+        ttlib::strindex m_index;
+        tt::CASE m_case;
+    };
+
+    /// Map of string keys to values of type V. Keys are unique using the map's CASE policy, and
+    /// entries are kept in the order they were added.
+    template <class V>
+    class strmap
+    {
+    public:
+        using value_type = std::pair<ttlib::cstr, V>;
+
+        strmap(tt::CASE checkcase = tt::CASE::exact) : m_index(checkcase), m_case(checkcase) {}
+
+        /// Returns the value for key, adding a default-constructed value if key isn't in the map.
+        V& operator[](std::string_view key)
+        {
+            if (auto pos = find(key); pos != tt::npos)
+                return m_entries[pos].second;
+            return add(key, V()).second;
+        }
+
+        /// Adds the key and value unless the map already contains key. Returns true if the entry
+        /// was added.
+        bool insert(std::string_view key, V value)
+        {
+            if (find(key) != tt::npos)
+                return false;
+            add(key, std::move(value));
+            return true;
+        }
+
+        /// Returns a pointer to the value for key, or nullptr if key isn't in the map.
+        V* get(std::string_view key)
+        {
+            auto pos = find(key);
+            return (pos != tt::npos) ? &m_entries[pos].second : nullptr;
+        }
+
+        const V* get(std::string_view key) const
+        {
+            auto pos = find(key);
+            return (pos != tt::npos) ? &m_entries[pos].second : nullptr;
+        }
+
+        /// Removes key if found. Returns true if the entry was removed. Only the positions of the
+        /// entries after the removed one are updated.
+        bool erase(std::string_view key)
+        {
+            auto pos = find(key);
+            if (pos == tt::npos)
+                return false;
+            m_index.erase(m_entries, pos, pos + 1, entry_key);
+            m_entries.erase(m_entries.begin() + pos);
+            return true;
+        }
+
+        /// Returns the position of key, or tt::npos if not found. See strset::find() for when the
+        /// hash index can be used.
+        size_t find(std::string_view key, tt::CASE checkcase) const
+        {
+            return m_index.find(m_entries, entry_key, key, checkcase);
+        }
+
+        size_t find(std::string_view key) const { return find(key, m_case); }
+
+        bool contains(std::string_view key) const { return find(key, m_case) != tt::npos; }
+        bool contains(std::string_view key, tt::CASE checkcase) const { return find(key, checkcase) != tt::npos; }
+
+        void clear()
+        {
+            m_entries.clear();
+            m_index.clear();
+        }
+
+        void reserve(size_t count)
+        {
+            m_entries.reserve(count);
+            m_index.reserve(count);
+        }
+
+        size_t size() const { return m_entries.size(); }
+        bool empty() const { return m_entries.empty(); }
+
+        /// Entries are in the order they were added. Don't change the key of an entry.
+        value_type& operator[](size_t pos) { return m_entries[pos]; }
+        const value_type& operator[](size_t pos) const { return m_entries[pos]; }
+        auto begin() { return m_entries.begin(); }
+        auto end() { return m_entries.end(); }
+        auto begin() const { return m_entries.begin(); }
+        auto end() const { return m_entries.end(); }
+
+        tt::CASE case_policy() const { return m_case; }
+
+    protected:
+        static std::string_view entry_key(const value_type& entry) { return entry.first; }
+
+        value_type& add(std::string_view key, V&& value)
+        {
+            m_index.add(key, m_entries.size());
+            return m_entries.emplace_back(ttlib::cstr(key), std::move(value));
+        }
+
+    private:
+        std::vector<value_type> m_entries;
+        ttlib::strindex m_index;
+        tt::CASE m_case;
+    };
+
+    inline bool has_member(const ttlib::strset& set, std::string_view str, tt::CASE checkcase = tt::CASE::exact)
+    {
+        return set.contains(str, checkcase);
+    }
+
+    template <class V>
+    bool has_member(const ttlib::strmap<V>& map, std::string_view key, tt::CASE checkcase = tt::CASE::exact)
+    {
+        return map.contains(key, checkcase);
+    }
+
+#if defined(_WIN32)
+    // Case-insensitive when compiled for Windows, otherwise case-sensitive
+    inline bool has_filename(const ttlib::strset& set, std::string_view str, tt::CASE checkcase = tt::CASE::either)
+#else
+    // Case-insensitive when compiled for Windows, otherwise case-sensitive
+    inline bool has_filename(const ttlib::strset& set, std::string_view str, tt::CASE checkcase = tt::CASE::exact)
+#endif
+    {
+        return set.contains(str, checkcase);
+    }
+
+    // Only adds the string if it doesn't already exist using the set's CASE policy. Unlike the
+    // std::vector version, there is no checkcase parameter -- a different CASE could add a
+    // string the set considers a duplicate.
+    inline void add_if(ttlib::strset& set, std::string_view str) { set.insert(str); }
+
+    // Only adds the key (with a default-constructed value) if it doesn't already exist using the
+    // map's CASE policy.
+    template <class V>
+    void add_if(ttlib::strmap<V>& map, std::string_view key)
+    {
+        map[key];
+    }
+
+    inline size_t find_member(const ttlib::strset& set, std::string_view str, tt::CASE checkcase = tt::CASE::exact)
+    {
+        return set.find(str, checkcase);
+    }
+
+    template <class V>
+    size_t find_member(const ttlib::strmap<V>& map, std::string_view key, tt::CASE checkcase = tt::CASE::exact)
+    {
+        return map.find(key, checkcase);
+    }
+}  // namespace ttlib
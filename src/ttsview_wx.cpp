@@ -9,7 +9,6 @@
 #include <cctype>
 #include <cstring>
 #include <filesystem>
-#include <locale>
 
 #include <ttlib_wx.h>  // ttlib namespace functions and declarations
 
@@ -19,57 +18,12 @@ using namespace ttlib;
 
 bool sview::is_sameas(std::string_view str, tt::CASE checkcase) const
 {
-    if (size() != str.size())
-        return false;
-
-    if (empty())
-        return str.empty();
-
-    // if both strings have the same length, then we can compare as a prefix.
-    return is_sameprefix(str, checkcase);
+    return ttlib::is_sameas(*this, str, checkcase);
 }
 
 bool sview::is_sameprefix(std::string_view str, tt::CASE checkcase) const
 {
-    if (str.empty())
-        return empty();
-
-    if (empty() || length() < str.length())
-        return false;
-
-    if (checkcase == tt::CASE::exact)
-    {
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (*iterMain++ != iterSub)
-                return false;
-        }
-        return true;
-    }
-    else if (checkcase == tt::CASE::either)
-    {
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (std::tolower(*iterMain++) != std::tolower(iterSub))
-                return false;
-        }
-        return true;
-    }
-    else if (checkcase == tt::CASE::utf8)
-    {
-        auto utf8locale = std::locale("en_US.utf8");
-        auto iterMain = begin();
-        for (auto iterSub: str)
-        {
-            if (std::tolower(*iterMain++, utf8locale) != std::tolower(iterSub, utf8locale))
-                return false;
-        }
-        return true;
-    }
-    assert(!"Unknown tt::CASE value");
-    return false;
+    return ttlib::is_sameprefix(*this, str, checkcase);
 }
 
 size_t sview::locate(std::string_view str, size_t posStart, tt::CASE checkcase) const
@@ -80,115 +34,35 @@ size_t sview::locate(std::string_view str, size_t posStart, tt::CASE checkcase)
     if (checkcase == tt::CASE::exact)
         return find(str, posStart);
 
-    if (checkcase == tt::CASE::either)
-    {
-        auto chLower = std::tolower(str[0]);
-        for (auto pos = posStart; pos < length(); ++pos)
-        {
-            if (std::tolower(at(pos)) == chLower)
-            {
-                size_t posSub;
-                for (posSub = 1; posSub < str.length(); ++posSub)
-                {
-                    if (pos + posSub >= length())
-                        return npos;
-                    if (std::tolower(at(pos + posSub)) != std::tolower(str.at(posSub)))
-                        break;
-                }
-                if (posSub >= str.length())
-                    return pos;
-            }
-        }
-    }
-    else
-    {
-        auto utf8locale = std::locale("en_US.utf8");
-        auto chLower = std::tolower(str[0], utf8locale);
-        for (auto pos = posStart; pos < length(); ++pos)
-        {
-            if (std::tolower(at(pos), utf8locale) == chLower)
-            {
-                size_t posSub;
-                for (posSub = 1; posSub < str.length(); ++posSub)
-                {
-                    if (pos + posSub >= length())
-                        return npos;
-                    if (std::tolower(at(pos + posSub), utf8locale) != std::tolower(str.at(posSub), utf8locale))
-                        break;
-                }
-                if (posSub >= str.length())
-                    return pos;
-            }
-        }
-    }
-    return npos;
+    auto pos = ttlib::findstr_pos<tt::CASE::either>(substr(posStart), str);
+    return (pos == npos) ? npos : pos + posStart;
 }
 
 bool sview::moveto_space() noexcept
 {
-    if (empty())
-        return false;
-    size_t pos;
-    for (pos = 0; pos < length(); ++pos)
-    {
-        if (ttlib::is_whitespace(at(pos)))
-            break;
-    }
-    if (pos >= length())
+    auto pos = ttlib::find_space_pos(*this);
+    if (pos == npos)
         return false;
-    else
-    {
-        remove_prefix(pos);
-        return true;
-    }
+    remove_prefix(pos);
+    return true;
 }
 
 bool sview::moveto_nonspace() noexcept
 {
-    if (empty())
-        return false;
-    size_t pos;
-    for (pos = 0; pos < length(); ++pos)
-    {
-        if (!ttlib::is_whitespace(at(pos)))
-            break;
-    }
-    if (pos >= length())
+    auto pos = ttlib::find_nonspace_pos(*this);
+    if (pos == npos)
         return false;
-    else
-    {
-        remove_prefix(pos);
-        return true;
-    }
+    remove_prefix(pos);
+    return true;
 }
 
 bool sview::moveto_nextword() noexcept
 {
-    if (empty())
-        return false;
-    size_t pos;
-    for (pos = 0; pos < length(); ++pos)
-    {
-        if (ttlib::is_whitespace(at(pos)))
-            break;
-    }
-    if (pos >= length())
+    auto pos = ttlib::stepover_pos(*this);
+    if (pos == npos)
         return false;
-
-    // whitespace found, look for non-whitespace
-    else
-    {
-        for (++pos; pos < length(); ++pos)
-        {
-            if (!ttlib::is_whitespace(at(pos)))
-                break;
-        }
-        if (pos >= length())
-            return false;
-
-        remove_prefix(pos);
-        return true;
-    }
+    remove_prefix(pos);
+    return true;
 }
 
 sview sview::view_digit(size_t start) const
@@ -364,43 +238,17 @@ ttlib::sview sview::filename() const noexcept
 
 bool sview::file_exists() const
 {
-    if (empty())
-        return false;
-#ifdef _WIN32
-    auto file = std::filesystem::directory_entry(std::filesystem::path((to_utf16())));
-#else
-    auto file = std::filesystem::directory_entry(std::filesystem::path(as_str()));
-#endif
-    return (file.exists() && !file.is_directory());
+    return ttlib::file_exists(*this);
 }
 
 bool sview::dir_exists() const
 {
-    if (empty())
-        return false;
-#ifdef _WIN32
-    auto file = std::filesystem::directory_entry(std::filesystem::path(to_utf16()));
-#else
-    auto file = std::filesystem::directory_entry(std::filesystem::path(as_str()));
-#endif
-    return (file.exists() && file.is_directory());
+    return ttlib::dir_exists(*this);
 }
 
-size_t sview::get_hash() const noexcept
+size_t sview::get_hash(tt::CASE checkcase) const noexcept
 {
-    if (empty())
-        return 0;
-
-    // djb2 hash algorithm
-
-    size_t hash = 5381;
-
-    for (auto iter: *this)
-    {
-        hash = ((hash << 5) + hash) ^ iter;
-    }
-
-    return hash;
+    return static_cast<size_t>(ttlib::get_hash(*this, checkcase));
 }
 
 size_t sview::find_oneof(const std::string& set, size_t start) const
@@ -426,22 +274,18 @@ size_t sview::find_oneof(sview set, size_t start) const
 
 size_t sview::find_space(size_t start) const
 {
-    for (; start < length(); ++start)
-    {
-        if (std::strchr(" \t\r\n\f", at(start)))
-            break;
-    }
-    return (start < length() ? start : tt::npos);
+    if (start >= length())
+        return tt::npos;
+    auto pos = ttlib::find_space_pos(subview(start));
+    return (pos != tt::npos ? start + pos : tt::npos);
 }
 
 size_t sview::find_nonspace(size_t start) const
 {
-    for (; start < length(); ++start)
-    {
-        if (!std::strchr(" \t\r\n\f", at(start)))
-            break;
-    }
-    return (start < length() ? start : tt::npos);
+    if (start >= length())
+        return tt::npos;
+    auto pos = ttlib::find_nonspace_pos(subview(start));
+    return (pos != tt::npos ? start + pos : tt::npos);
 }
 
 size_t sview::stepover(size_t start) const
@@ -541,15 +385,8 @@ sview sview::subview(size_t start, size_t len) const
 
 sview sview::find_space(std::string_view str) noexcept
 {
-    if (str.empty())
-        return ttlib::emptystring;
-    size_t pos;
-    for (pos = 0; pos < str.length(); ++pos)
-    {
-        if (ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
+    auto pos = ttlib::find_space_pos(str);
+    if (pos == tt::npos)
         return ttlib::emptystring;
     else
         return sview(str.data() + pos, str.length() - pos);
@@ -557,15 +394,8 @@ sview sview::find_space(std::string_view str) noexcept
 
 sview sview::find_nonspace(std::string_view str) noexcept
 {
-    if (str.empty())
-        return ttlib::emptystring;
-    size_t pos;
-    for (pos = 0; pos < str.length(); ++pos)
-    {
-        if (!ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
+    auto pos = ttlib::find_nonspace_pos(str);
+    if (pos == tt::npos)
         return ttlib::emptystring;
     else
         return sview(str.data() + pos, str.length() - pos);
@@ -573,24 +403,8 @@ sview sview::find_nonspace(std::string_view str) noexcept
 
 sview sview::stepover(std::string_view str) noexcept
 {
-    if (str.empty())
-        return ttlib::emptystring;
-
-    size_t pos;
-    for (pos = 0; pos < str.length(); ++pos)
-    {
-        if (ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
-        return ttlib::emptystring;
-
-    for (; pos < str.length(); ++pos)
-    {
-        if (!ttlib::is_whitespace(str.at(pos)))
-            break;
-    }
-    if (pos >= str.length())
+    auto pos = ttlib::stepover_pos(str);
+    if (pos == tt::npos)
         return ttlib::emptystring;
     else
         return sview(str.data() + pos, str.length() - pos);
@@ -604,16 +418,8 @@ sview& sview::trim(tt::TRIM where)
     if (where == tt::TRIM::right || where == tt::TRIM::both)
     {
         auto len = length();
-        for (--len; len != std::string::npos; --len)
-        {
-            // char ch = at(len);
-            char ch = data()[len];
-            if (ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n' && ch != '\f')
-            {
-                ++len;
-                break;
-            }
-        }
+        while (len > 0 && ttlib::is_whitespace(data()[len - 1]))
+            --len;
 
         if (len < length())
             remove_suffix(length() - len);
@@ -627,13 +433,8 @@ sview& sview::trim(tt::TRIM where)
         if (!ttlib::is_whitespace(front()))
             return *this;
 
-        size_t pos;
-        for (pos = 1; pos < length(); ++pos)
-        {
-            if (!ttlib::is_whitespace(data()[pos]))
-                break;
-        }
-        remove_prefix(pos);
+        auto pos = ttlib::find_nonspace_pos(*this);
+        remove_prefix(pos != tt::npos ? pos : length());
     }
 
     return *this;
@@ -186,8 +186,9 @@ namespace ttlib
         /// Equivalent to find_nonspace(find_space(str)).
         static sview stepover(std::string_view str) noexcept;
 
-        /// Generates hash of current string using djb2 hash algorithm
-        size_t get_hash() const noexcept;
+        /// Generates a hash of the current string (see ttlib::get_hash). Strings that differ only
+        /// in ASCII case generate the same hash if checkcase is CASE::either or CASE::utf8.
+        size_t get_hash(tt::CASE checkcase = tt::CASE::exact) const noexcept;
 
         /////////////////////////////////////////////////////////////////////////////////
         // Note: all moveto_() functions start from the beginning of the sview. On success
@@ -229,3 +230,10 @@ namespace ttlib
         bool operator==(ttlib::sview str) { return this->is_sameas(str); }
     };
 }  // namespace ttlib
+
+// Allows ttlib::sview to be used as a key in std::unordered_map and std::unordered_set
+template <>
+struct std::hash<ttlib::sview>
+{
+    size_t operator()(const ttlib::sview& str) const noexcept { return str.get_hash(); }
+};
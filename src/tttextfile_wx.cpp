@@ -5,6 +5,7 @@
 // License:   Apache License -- see ../../LICENSE
 /////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>  // memcmp
 #include <fstream>
 
 #include <ttlib_wx.h>  // ttlib namespace functions and declarations
@@ -14,9 +15,46 @@
 using namespace ttlib;
 using namespace tt;
 
-bool textfile::ReadFile(std::string_view filename)
+namespace
+{
+    // Most changes to a file change the length of at least one line, so every line length is
+    // compared before any text is compared.
+    template <class T1, class T2>
+    bool is_same_lines(const T1& lines1, const T2& lines2, CASE checkcase)
+    {
+        if (lines1.size() != lines2.size())
+            return false;
+
+        for (size_t pos = 0; pos < lines1.size(); ++pos)
+        {
+            if (lines1[pos].size() != lines2[pos].size())
+                return false;
+        }
+
+        if (checkcase == CASE::exact)
+        {
+            for (size_t pos = 0; pos < lines1.size(); ++pos)
+            {
+                if (!ttlib::is_sameas<CASE::exact>(lines1[pos], lines2[pos]))
+                    return false;
+            }
+        }
+        else
+        {
+            for (size_t pos = 0; pos < lines1.size(); ++pos)
+            {
+                if (!ttlib::is_sameas<CASE::either>(lines1[pos], lines2[pos]))
+                    return false;
+            }
+        }
+        return true;
+    }
+}  // anonymous namespace
+
+bool textfile::ReadFile(std::string_view filename, bool validate)
 {
     m_filename.assign(filename);
+    m_utf8_error = tt::npos;
     clear();
 #if defined(_WIN32)
     auto path = std::filesystem::path(m_filename.wx_str());
@@ -27,6 +65,15 @@ bool textfile::ReadFile(std::string_view filename)
     if (!file.is_open())
         return false;
     std::string buf(std::istreambuf_iterator<char>(file), {});
+
+    // A UTF-16 file is always converted into valid UTF-8, so only UTF-8 content is validated.
+    if (validate && !(buf.size() > 2 && buf[0] == static_cast<char>(0xFF) && buf[1] == static_cast<char>(0xFE)))
+    {
+        m_utf8_error = ttlib::validate_utf8(buf);
+        if (m_utf8_error != tt::npos)
+            return false;
+    }
+
     if (buf.size() > 2)
     {
         // Check for BOM LE or BOM UTF-8 -- other types are not supported.
@@ -160,45 +207,41 @@ size_t textfile::ReplaceInLine(std::string_view orgStr, std::string_view newStr,
     return tt::npos;
 }
 
-bool textfile::is_sameas(viewfile other, CASE checkcase) const
+bool textfile::is_sameas(const viewfile& other, CASE checkcase) const
 {
-    if (size() != other.size())
-        return false;
-
-    size_t pos = 0;
-    for (; pos < other.size(); ++pos)
-    {
-        if (!at(pos).is_sameas(other[pos], checkcase))
-            break;
-    }
-    return (pos == size());
+    return is_same_lines(*this, other, checkcase);
 }
 
-bool textfile::is_sameas(textfile other, CASE checkcase) const
+bool textfile::is_sameas(const textfile& other, CASE checkcase) const
 {
-    if (size() != other.size())
-        return false;
-
-    size_t pos = 0;
-    for (; pos < other.size(); ++pos)
-    {
-        if (!at(pos).is_sameas(other[pos], checkcase))
-            break;
-    }
-    return (pos == size());
+    return is_same_lines(*this, other, checkcase);
 }
 
 /////////////////////// ttViewFile /////////////////////////////////
 
-bool viewfile::ReadFile(std::string_view filename)
+bool viewfile::ReadFile(std::string_view filename, bool validate)
 {
     m_filename.assign(filename);
+    m_utf8_error = tt::npos;
 
     clear();
     std::ifstream file(m_filename, std::ios::binary);
     if (!file.is_open())
         return false;
     m_buffer.assign(std::istreambuf_iterator<char>(file), {});
+
+    // A UTF-16 file is always converted into valid UTF-8, so only UTF-8 content is validated.
+    if (validate &&
+        !(m_buffer.size() > 2 && m_buffer[0] == static_cast<char>(0xFF) && m_buffer[1] == static_cast<char>(0xFE)))
+    {
+        m_utf8_error = ttlib::validate_utf8(m_buffer);
+        if (m_utf8_error != tt::npos)
+        {
+            m_buffer.clear();
+            return false;
+        }
+    }
+
     if (m_buffer.size() > 2)
     {
         // Check for BOM LE or BOM UTF-8 -- other types are not supported.
@@ -336,30 +379,44 @@ size_t viewfile::FindLineContaining(std::string_view str, size_t start, tt::CASE
     return tt::npos;
 }
 
-bool viewfile::is_sameas(viewfile other, CASE checkcase) const
+bool viewfile::is_sameas(const viewfile& other, CASE checkcase) const
 {
     if (size() != other.size())
         return false;
 
-    size_t pos = 0;
-    for (; pos < other.size(); ++pos)
+    // If both buffers are identical, and every line is at the same offset in each buffer, then
+    // the lines are identical without comparing them individually.
+    if (checkcase == CASE::exact && m_buffer.size() == other.m_buffer.size() &&
+        std::memcmp(m_buffer.data(), other.m_buffer.data(), m_buffer.size()) == 0)
     {
-        if (!ttlib::is_sameas(at(pos), other[pos], checkcase))
-            break;
+        size_t pos = 0;
+        for (; pos < size(); ++pos)
+        {
+            auto& line = at(pos);
+            auto& other_line = other[pos];
+            if (line.size() != other_line.size())
+                return false;
+            if (line.empty())
+                continue;  // empty lines may have a nullptr data()
+
+            // A line could have been changed to point outside of the buffer, in which case
+            // the offset is not within the buffer.
+            auto offset = reinterpret_cast<uintptr_t>(line.data()) - reinterpret_cast<uintptr_t>(m_buffer.data());
+            auto other_offset =
+                reinterpret_cast<uintptr_t>(other_line.data()) - reinterpret_cast<uintptr_t>(other.m_buffer.data());
+            if (offset > m_buffer.size() || line.size() > m_buffer.size() - offset || offset != other_offset)
+            {
+                break;
+            }
+        }
+        if (pos == size())
+            return true;
     }
-    return (pos == size());
+
+    return is_same_lines(*this, other, checkcase);
 }
 
-bool viewfile::is_sameas(textfile other, CASE checkcase) const
+bool viewfile::is_sameas(const textfile& other, CASE checkcase) const
 {
-    if (size() != other.size())
-        return false;
-
-    size_t pos = 0;
-    for (; pos < other.size(); ++pos)
-    {
-        if (!ttlib::is_sameas(at(pos), other[pos], checkcase))
-            break;
-    }
-    return (pos == size());
+    return is_same_lines(*this, other, checkcase);
 }
@@ -51,7 +51,14 @@ namespace ttlib
     public:
         /// Reads a line-oriented file and converts each line into a ttlib::cstr
         /// (std::string).
-        bool ReadFile(std::string_view filename);
+        ///
+        /// If validate is true and the file is not valid UTF-8, no lines are read, false is
+        /// returned, and utf8_error() will return the offset of the first invalid byte.
+        bool ReadFile(std::string_view filename, bool validate = false);
+
+        /// Returns the file offset of the first invalid UTF-8 sequence found by the last call to
+        /// ReadFile(filename, true), or tt::npos if no invalid sequence was found.
+        size_t utf8_error() const { return m_utf8_error; }
 
         /// This will be the filename passed to ReadFile()
         ttlib::cstr& filename() { return m_filename; }
@@ -96,8 +103,10 @@ namespace ttlib
         size_t ReplaceInLine(std::string_view orgStr, std::string_view newStr, size_t startline = 0,
                              tt::CASE checkcase = tt::CASE::exact);
 
-        bool is_sameas(ttlib::textfile other, tt::CASE checkcase = tt::CASE::exact) const;
-        bool is_sameas(ttlib::viewfile other, tt::CASE checkcase = tt::CASE::exact) const;
+        /// Returns true if both files have the same lines. The length of every line is compared
+        /// before any text is compared.
+        bool is_sameas(const ttlib::textfile& other, tt::CASE checkcase = tt::CASE::exact) const;
+        bool is_sameas(const ttlib::viewfile& other, tt::CASE checkcase = tt::CASE::exact) const;
 
         /// Use addEmptyLine() if you need to modify the line after adding it to the end.
         ///
@@ -145,6 +154,7 @@ namespace ttlib
 
     private:
         ttlib::cstr m_filename;
+        size_t m_utf8_error { tt::npos };
     };
 }  // namespace ttlib
 
@@ -159,7 +169,14 @@ namespace ttlib
     {
     public:
         /// Reads a line-oriented file and converts each line into a std::string.
-        bool ReadFile(std::string_view filename);
+        ///
+        /// If validate is true and the file is not valid UTF-8, no lines are read, false is
+        /// returned, and utf8_error() will return the offset of the first invalid byte.
+        bool ReadFile(std::string_view filename, bool validate = false);
+
+        /// Returns the file offset of the first invalid UTF-8 sequence found by the last call to
+        /// ReadFile(filename, true), or tt::npos if no invalid sequence was found.
+        size_t utf8_error() const { return m_utf8_error; }
 
         /// This will be the filename passed to ReadFile()
         ttlib::cstr& filename() { return m_filename; }
@@ -186,8 +203,10 @@ namespace ttlib
         /// startline is the zero-based offset to the line to start searching.
         size_t FindLineContaining(std::string_view str, size_t startline = 0, tt::CASE checkcase = tt::CASE::exact) const;
 
-        bool is_sameas(ttlib::textfile other, tt::CASE checkcase = tt::CASE::exact) const;
-        bool is_sameas(ttlib::viewfile other, tt::CASE checkcase = tt::CASE::exact) const;
+        /// Returns true if both files have the same lines. When comparing two viewfiles with
+        /// CASE::exact, a single memcmp() of the buffers is tried before comparing each line.
+        bool is_sameas(const ttlib::textfile& other, tt::CASE checkcase = tt::CASE::exact) const;
+        bool is_sameas(const ttlib::viewfile& other, tt::CASE checkcase = tt::CASE::exact) const;
 
     protected:
         // Converts lines into a vector of std::string_view members. Lines can end with \n, \r, or \r\n.
@@ -196,5 +215,6 @@ namespace ttlib
     private:
         ttlib::cstr m_buffer;
         ttlib::cstr m_filename;
+        size_t m_utf8_error { tt::npos };
     };
 }  // namespace ttlib
@@ -0,0 +1,375 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   UTF-8 code point decoding, iteration, counting and indexing
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <cwchar>  // WCHAR_MAX
+#include <locale>
+
+#include <ttlib_wx.h>  // ttlib namespace functions and declarations
+
+#include <ttutf8_wx.h>
+
+#if defined(TTLIB_SSE2)
+    #include <emmintrin.h>
+#endif
+
+using namespace ttlib;
+
+// Every byte that is not a continuation byte (10xxxxxx) starts a code point, so counting code
+// points only requires counting those bytes.
+
+namespace
+{
+    inline bool is_lead_byte(char ch) noexcept
+    {
+        return (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+    }
+
+    // Returns the number of lead bytes in the 8 bytes at ptr.
+    inline size_t count_leads8(const char* ptr) noexcept
+    {
+        uint64_t word;
+        std::memcpy(&word, ptr, sizeof(word));
+
+        // The high bit of each byte is set if the byte is a continuation byte.
+        uint64_t continuation = (word & ~(word << 1)) & 0x8080808080808080ull;
+        return 8 - static_cast<size_t>(((continuation >> 7) * 0x0101010101010101ull) >> 56);
+    }
+
+#if defined(TTLIB_SSE2)
+    // Continuation bytes are 0x80 through 0xBF, which is -128 through -65 as signed char.
+    inline __m128i lead_bytes16(const char* ptr) noexcept
+    {
+        return _mm_cmpgt_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), _mm_set1_epi8(-65));
+    }
+
+    inline size_t popcount16(unsigned int mask) noexcept
+    {
+        mask = mask - ((mask >> 1) & 0x5555);
+        mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+        mask = (mask + (mask >> 4)) & 0x0F0F;
+        return (mask + (mask >> 8)) & 0x1F;
+    }
+#endif  // TTLIB_SSE2
+}  // anonymous namespace
+
+utf8_iterator& utf8_iterator::operator--() noexcept
+{
+    if (m_pos == m_begin)
+        return *this;
+
+    // Find the closest lead byte and make certain that decoding from it ends at the current
+    // position. If it doesn't, then the previous byte is a stray continuation byte which
+    // operator++ would have stepped over by itself.
+    auto target = m_pos;
+    auto limit = (target - m_begin) > 4 ? target - 4 : m_begin;
+    auto ptr = target - 1;
+    while (ptr > limit && !is_lead_byte(*ptr))
+        --ptr;
+
+    char32_t codepoint;
+    bool valid = true;
+    if (decode_utf8(ptr, static_cast<size_t>(m_end - ptr), codepoint, valid) == static_cast<size_t>(target - ptr))
+        m_pos = ptr;
+    else
+        m_pos = target - 1;
+    return *this;
+}
+
+size_t ttlib::utf8_length(std::string_view str) noexcept
+{
+    size_t count = 0;
+    size_t pos = 0;
+
+#if defined(TTLIB_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    while (pos + 16 <= str.size())
+    {
+        // Each byte counter in accumulator can only be incremented 255 times before it overflows.
+        auto blocks = std::min<size_t>((str.size() - pos) / 16, 255);
+        __m128i accumulator = zero;
+        for (size_t block = 0; block < blocks; ++block, pos += 16)
+            accumulator = _mm_sub_epi8(accumulator, lead_bytes16(str.data() + pos));
+
+        __m128i sums = _mm_sad_epu8(accumulator, zero);
+        count += static_cast<size_t>(_mm_cvtsi128_si32(sums)) +
+                 static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#else
+    for (; pos + 8 <= str.size(); pos += 8)
+        count += count_leads8(str.data() + pos);
+#endif  // TTLIB_SSE2
+
+    for (; pos < str.size(); ++pos)
+    {
+        if (is_lead_byte(str[pos]))
+            ++count;
+    }
+    return count;
+}
+
+size_t ttlib::utf8_offset_of(std::string_view str, size_t codepoint) noexcept
+{
+    size_t pos = 0;
+
+    // Skip over entire blocks as long as they don't contain the code point we're looking for.
+#if defined(TTLIB_SSE2)
+    while (pos + 16 <= str.size())
+    {
+        auto count = popcount16(static_cast<unsigned int>(_mm_movemask_epi8(lead_bytes16(str.data() + pos))));
+        if (count > codepoint)
+            break;
+        codepoint -= count;
+        pos += 16;
+    }
+#endif  // TTLIB_SSE2
+    while (pos + 8 <= str.size())
+    {
+        auto count = count_leads8(str.data() + pos);
+        if (count > codepoint)
+            break;
+        codepoint -= count;
+        pos += 8;
+    }
+
+    for (; pos < str.size(); ++pos)
+    {
+        if (is_lead_byte(str[pos]))
+        {
+            if (codepoint == 0)
+                return pos;
+            --codepoint;
+        }
+    }
+    return (codepoint == 0) ? str.size() : tt::npos;
+}
+
+utf8_index::utf8_index(std::string_view str, size_t stride) : m_str(str), m_stride(stride ? stride : 64)
+{
+    m_offsets.push_back(0);
+    size_t pos = 0;
+    for (;;)
+    {
+        auto next = utf8_offset_of(m_str.substr(pos), m_stride);
+        if (next == tt::npos || pos + next >= m_str.size())
+            break;
+        pos += next;
+        m_offsets.push_back(pos);
+    }
+    m_length = (m_offsets.size() - 1) * m_stride + utf8_length(m_str.substr(m_offsets.back()));
+}
+
+size_t utf8_index::offset_of(size_t codepoint) const noexcept
+{
+    if (codepoint >= m_length)
+        return (codepoint == m_length) ? m_str.size() : tt::npos;
+
+    auto base = m_offsets[codepoint / m_stride];
+    return base + utf8_offset_of(m_str.substr(base), codepoint % m_stride);
+}
+
+size_t utf8_index::codepoint_of(size_t offset) const noexcept
+{
+    if (offset >= m_str.size())
+        return m_length;
+
+    // Find the last stored offset that is not past offset.
+    auto iter = std::upper_bound(m_offsets.begin(), m_offsets.end(), offset) - 1;
+    auto block = static_cast<size_t>(iter - m_offsets.begin());
+
+    // Count the lead bytes up to and including offset -- the last one counted is the start of
+    // the code point containing offset.
+    auto count = utf8_length(m_str.substr(*iter, offset - *iter + 1));
+    return block * m_stride + (count ? count - 1 : 0);
+}
+
+/////////////////////////////////////// case mapping ///////////////////////////////////////
+
+namespace
+{
+    // Returns the wchar_t ctype facet of a UTF-8 locale, or the classic locale if no UTF-8 locale
+    // is available. The locale is only created once.
+    const std::ctype<wchar_t>& wide_ctype()
+    {
+        static const std::locale locale = []()
+        {
+            for (auto name: { "en_US.UTF-8", "en_US.utf8", "C.UTF-8", "" })
+            {
+                try
+                {
+                    return std::locale(name);
+                }
+                catch (const std::exception& /* e */)
+                {
+                }
+            }
+            return std::locale::classic();
+        }();
+        return std::use_facet<std::ctype<wchar_t>>(locale);
+    }
+
+    template <bool upper>
+    inline char map_ascii(char ch) noexcept
+    {
+        if constexpr (upper)
+            return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - ('a' - 'A')) : ch;
+        else
+            return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch + ('a' - 'A')) : ch;
+    }
+
+    template <bool upper>
+    char32_t map_codepoint(char32_t codepoint) noexcept
+    {
+        if (codepoint > static_cast<char32_t>(WCHAR_MAX) || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            return codepoint;
+
+        auto& facet = wide_ctype();
+        auto mapped = static_cast<char32_t>(upper ? facet.toupper(static_cast<wchar_t>(codepoint)) :
+                                                    facet.tolower(static_cast<wchar_t>(codepoint)));
+
+        // Never let the mapping turn a character into something that can't be encoded.
+        if (mapped > 0x10FFFF || (mapped >= 0xD800 && mapped <= 0xDFFF))
+            return codepoint;
+        return mapped;
+    }
+
+    // If all 16 bytes at src are ASCII, writes their case-mapped form to dst and returns true.
+    template <bool upper>
+    inline bool map_ascii16(const char* src, char* dst) noexcept
+    {
+#if defined(TTLIB_SSE2)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        if (_mm_movemask_epi8(bytes))
+            return false;
+        const __m128i before_first = _mm_set1_epi8(upper ? 'a' - 1 : 'A' - 1);
+        const __m128i after_last = _mm_set1_epi8(upper ? 'z' + 1 : 'Z' + 1);
+        __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(bytes, before_first), _mm_cmplt_epi8(bytes, after_last));
+        bytes = _mm_xor_si128(bytes, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), bytes);
+        return true;
+#else
+        // SWAR version: the high bit of each byte is used to flag the letters that need to change.
+        constexpr uint64_t ones = 0x0101010101010101ull;
+        constexpr uint64_t high_bits = 0x8080808080808080ull;
+        uint64_t words[2];
+        std::memcpy(words, src, sizeof(words));
+        if ((words[0] | words[1]) & high_bits)
+            return false;
+        for (auto& word: words)
+        {
+            uint64_t at_or_after_first = word + (0x80 - (upper ? 'a' : 'A')) * ones;
+            uint64_t after_last = word + (0x80 - (upper ? 'z' : 'Z') - 1) * ones;
+            word ^= ((at_or_after_first ^ after_last) & high_bits) >> 2;
+        }
+        std::memcpy(dst, words, sizeof(words));
+        return true;
+#endif  // TTLIB_SSE2
+    }
+
+    template <bool upper>
+    size_t convert_case(std::string_view src, char* dst, size_t dst_size) noexcept
+    {
+        size_t pos = 0;
+        size_t out = 0;
+        while (pos < src.size())
+        {
+            if (pos + 16 <= src.size() && out + 16 <= dst_size && map_ascii16<upper>(src.data() + pos, dst + out))
+            {
+                pos += 16;
+                out += 16;
+                continue;
+            }
+
+            if (static_cast<unsigned char>(src[pos]) < 0x80)
+            {
+                if (out < dst_size)
+                    dst[out] = map_ascii<upper>(src[pos]);
+                ++pos;
+                ++out;
+                continue;
+            }
+
+            char32_t codepoint;
+            bool valid = true;
+            auto consumed = decode_utf8(src.data() + pos, src.size() - pos, codepoint, valid);
+            char buffer[4];
+            auto bytes = std::string_view(src.data() + pos, consumed);
+            if (valid)
+                bytes = std::string_view(buffer, encode_utf8(map_codepoint<upper>(codepoint), buffer) - buffer);
+
+            if (out + bytes.size() <= dst_size)
+                std::memcpy(dst + out, bytes.data(), bytes.size());
+            pos += consumed;
+            out += bytes.size();
+        }
+        return out;
+    }
+
+    template <bool upper>
+    void convert_case(std::string& str)
+    {
+        // Convert in place until a character is found whose mapping needs a different number of
+        // bytes. Anything converted up to that point is unchanged by converting it again.
+        size_t pos = 0;
+        while (pos < str.size())
+        {
+            if (pos + 16 <= str.size() && map_ascii16<upper>(str.data() + pos, str.data() + pos))
+            {
+                pos += 16;
+                continue;
+            }
+
+            if (static_cast<unsigned char>(str[pos]) < 0x80)
+            {
+                str[pos] = map_ascii<upper>(str[pos]);
+                ++pos;
+                continue;
+            }
+
+            char32_t codepoint;
+            bool valid = true;
+            auto consumed = decode_utf8(str.data() + pos, str.size() - pos, codepoint, valid);
+            if (valid)
+            {
+                auto mapped = map_codepoint<upper>(codepoint);
+                if (utf8_size(mapped) != consumed)
+                    break;
+                encode_utf8(mapped, str.data() + pos);
+            }
+            pos += consumed;
+        }
+
+        if (pos < str.size())
+        {
+            std::string result;
+            result.resize(convert_case<upper>(str, nullptr, 0));
+            convert_case<upper>(str, result.data(), result.size());
+            str.swap(result);
+        }
+    }
+}  // anonymous namespace
+
+size_t ttlib::to_lower_copy(std::string_view src, char* dst, size_t dst_size) noexcept
+{
+    return convert_case<false>(src, dst, dst_size);
+}
+
+size_t ttlib::to_upper_copy(std::string_view src, char* dst, size_t dst_size) noexcept
+{
+    return convert_case<true>(src, dst, dst_size);
+}
+
+void ttlib::make_lower(std::string& str)
+{
+    convert_case<false>(str);
+}
+
+void ttlib::make_upper(std::string& str)
+{
+    convert_case<true>(str);
+}
@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////////////
+// Purpose:   UTF-8 code point decoding, iteration, counting and indexing
+// Author:    Ralph Walden
+// Copyright: Copyright (c) 2023 KeyWorks Software (Ralph Walden)
+// License:   Apache License -- see ../../LICENSE
+/////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+    #error "The contents of ttutf8_wx.h are available only with C++17 or later."
+#endif
+
+/// @file
+///
+/// ttlib::utf8_range lets you iterate through the code points of a ttlib::sview, ttlib::cstr or any
+/// other string that converts to a std::string_view. The iterator is bidirectional, so it can also
+/// be used with std::make_reverse_iterator() or to step backwards from a known position.
+///
+///     for (auto codepoint: ttlib::utf8_range(str))
+///         ...
+///
+/// ttlib::utf8_length() returns the number of code points, and ttlib::utf8_offset_of() converts a
+/// code point index into a byte offset. If you need to make many conversions on the same string
+/// (e.g., calculating columns for diagnostics on a long line), create a ttlib::utf8_index which
+/// stores the byte offset of every nth code point so that each conversion only needs to scan a
+/// short distance.
+///
+/// ttlib::make_lower(), ttlib::make_upper(), ttlib::to_lower_copy() and ttlib::to_upper_copy()
+/// change the case of ASCII characters 16 at a time, and use the wchar_t ctype facet of a UTF-8
+/// locale for everything else.
+
+#include <cstdint>      // uint32_t
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>
+
+#include "ttlib_wx.h"  // ttlib namespace functions and declarations
+
+namespace ttlib
+{
+    /// Invalid sequences are decoded as this code point.
+    constexpr char32_t replacement_char = 0xFFFD;
+
+    /// Decodes the code point starting at ptr, returning the number of bytes consumed.
+    ///
+    /// If the sequence is invalid (overlong, surrogate, truncated, or above U+10FFFF),
+    /// codepoint is set to U+FFFD and valid is set to false. Only the bytes that form the
+    /// longest valid prefix of a sequence are consumed (always at least one). valid is never
+    /// set to true, so it can be used to accumulate errors across multiple calls.
+    inline size_t decode_utf8(const char* ptr, size_t remaining, char32_t& codepoint, bool& valid) noexcept
+    {
+        const auto lead = static_cast<unsigned char>(ptr[0]);
+        if (lead < 0x80)
+        {
+            codepoint = lead;
+            return 1;
+        }
+
+        size_t count;
+        unsigned char lower = 0x80;
+        unsigned char upper = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            count = 2;
+            codepoint = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            count = 3;
+            codepoint = lead & 0x0F;
+            if (lead == 0xE0)
+                lower = 0xA0;  // overlong
+            else if (lead == 0xED)
+                upper = 0x9F;  // surrogates
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            count = 4;
+            codepoint = lead & 0x07;
+            if (lead == 0xF0)
+                lower = 0x90;  // overlong
+            else if (lead == 0xF4)
+                upper = 0x8F;  // > U+10FFFF
+        }
+        else
+        {
+            codepoint = replacement_char;
+            valid = false;
+            return 1;
+        }
+
+        for (size_t pos = 1; pos < count; ++pos)
+        {
+            if (pos >= remaining)
+            {
+                codepoint = replacement_char;
+                valid = false;
+                return pos;
+            }
+            const auto next = static_cast<unsigned char>(ptr[pos]);
+            if (next < lower || next > upper)
+            {
+                codepoint = replacement_char;
+                valid = false;
+                return pos;
+            }
+            codepoint = (codepoint << 6) | (next & 0x3F);
+            lower = 0x80;
+            upper = 0xBF;
+        }
+        return count;
+    }
+
+    /// Returns the number of bytes needed to encode codepoint as UTF-8.
+    constexpr size_t utf8_size(char32_t codepoint) noexcept
+    {
+        return codepoint < 0x80 ? 1 : codepoint < 0x800 ? 2 : codepoint < 0x10000 ? 3 : 4;
+    }
+
+    /// Writes the UTF-8 encoding of codepoint to dst and returns a pointer past the last byte
+    /// written. dst must have room for utf8_size(codepoint) bytes.
+    inline char* encode_utf8(char32_t codepoint, char* dst) noexcept
+    {
+        if (codepoint < 0x80)
+        {
+            *dst++ = static_cast<char>(codepoint);
+        }
+        else if (codepoint < 0x800)
+        {
+            *dst++ = static_cast<char>(0xC0 | (codepoint >> 6));
+            *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else if (codepoint < 0x10000)
+        {
+            *dst++ = static_cast<char>(0xE0 | (codepoint >> 12));
+            *dst++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else
+        {
+            *dst++ = static_cast<char>(0xF0 | (codepoint >> 18));
+            *dst++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        return dst;
+    }
+
+    /// Bidirectional iterator that returns each code point in a UTF-8 string. Invalid sequences
+    /// are returned as U+FFFD.
+    class utf8_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = char32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char32_t*;
+        using reference = char32_t;
+
+        utf8_iterator() = default;
+
+        /// str is the entire string, pos is the byte offset within str to start at.
+        utf8_iterator(std::string_view str, size_t pos) :
+            m_begin(str.data()), m_end(str.data() + str.size()), m_pos(str.data() + (pos < str.size() ? pos : str.size()))
+        {
+        }
+
+        char32_t operator*() const noexcept
+        {
+            char32_t codepoint;
+            bool valid = true;
+            decode_utf8(m_pos, static_cast<size_t>(m_end - m_pos), codepoint, valid);
+            return codepoint;
+        }
+
+        utf8_iterator& operator++() noexcept
+        {
+            char32_t codepoint;
+            bool valid = true;
+            m_pos += decode_utf8(m_pos, static_cast<size_t>(m_end - m_pos), codepoint, valid);
+            return *this;
+        }
+
+        utf8_iterator operator++(int) noexcept
+        {
+            auto prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        utf8_iterator& operator--() noexcept;
+
+        utf8_iterator operator--(int) noexcept
+        {
+            auto prev = *this;
+            --*this;
+            return prev;
+        }
+
+        bool operator==(const utf8_iterator& other) const noexcept { return m_pos == other.m_pos; }
+        bool operator!=(const utf8_iterator& other) const noexcept { return m_pos != other.m_pos; }
+
+        /// Returns the byte offset of the current code point from the start of the string.
+        size_t offset() const noexcept { return static_cast<size_t>(m_pos - m_begin); }
+
+        /// Returns a view of the bytes that make up the current code point.
+        std::string_view bytes() const noexcept
+        {
+            char32_t codepoint;
+            bool valid = true;
+            return std::string_view(m_pos, decode_utf8(m_pos, static_cast<size_t>(m_end - m_pos), codepoint, valid));
+        }
+
+    private:
+        const char* m_begin { nullptr };
+        const char* m_end { nullptr };
+        const char* m_pos { nullptr };
+    };
+
+    /// Range for iterating through the code points of a UTF-8 string. The string must remain
+    /// valid for as long as the range or any of its iterators are used.
+    class utf8_range
+    {
+    public:
+        utf8_range(std::string_view str) : m_str(str) {}
+
+        utf8_iterator begin() const noexcept { return utf8_iterator(m_str, 0); }
+        utf8_iterator end() const noexcept { return utf8_iterator(m_str, m_str.size()); }
+
+        auto rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+        auto rend() const noexcept { return std::make_reverse_iterator(begin()); }
+
+    private:
+        std::string_view m_str;
+    };
+
+    /// Returns the number of code points in str. Each byte that is not a continuation byte
+    /// counts as one code point, which is exact for valid UTF-8.
+    size_t utf8_length(std::string_view str) noexcept;
+
+    /// Returns the byte offset of the code point at index codepoint, or tt::npos if str
+    /// contains fewer code points. If codepoint is equal to the number of code points,
+    /// str.size() is returned.
+    size_t utf8_offset_of(std::string_view str, size_t codepoint) noexcept;
+
+    /// Converts src to lower case, writing the result to dst. No more than dst_size bytes are
+    /// written, but the return value is always the number of bytes the full conversion needs,
+    /// which can differ from src.size() for a few non-ASCII characters. dst is not
+    /// null-terminated. Invalid UTF-8 sequences are copied unchanged.
+    size_t to_lower_copy(std::string_view src, char* dst, size_t dst_size) noexcept;
+
+    /// Converts src to upper case, writing the result to dst. See to_lower_copy() for details.
+    size_t to_upper_copy(std::string_view src, char* dst, size_t dst_size) noexcept;
+
+    /// Converts a UTF-8 string to lower case. The conversion is done in place unless a
+    /// character's lower case form needs a different number of bytes.
+    void make_lower(std::string& str);
+
+    /// Converts a UTF-8 string to upper case. The conversion is done in place unless a
+    /// character's upper case form needs a different number of bytes.
+    void make_upper(std::string& str);
+
+    /// Stores the byte offset of every nth code point in a string so that converting between
+    /// code point indexes and byte offsets only requires scanning a short distance. The
+    /// string must remain valid and unchanged for as long as the index is used.
+    class utf8_index
+    {
+    public:
+        /// stride is the number of code points between each stored offset.
+        utf8_index(std::string_view str, size_t stride = 64);
+
+        /// Returns the number of code points in the string.
+        size_t length() const noexcept { return m_length; }
+
+        /// Returns the byte offset of the code point at index codepoint, or tt::npos if the
+        /// string contains fewer code points.
+        size_t offset_of(size_t codepoint) const noexcept;
+
+        /// Returns the index of the code point that contains the byte at offset. Use this to
+        /// convert a byte offset into a column number.
+        size_t codepoint_of(size_t offset) const noexcept;
+
+    private:
+        std::string_view m_str;
+        std::vector<size_t> m_offsets;  // m_offsets[i] is the byte offset of code point i * m_stride
+        size_t m_stride;
+        size_t m_length { 0 };
+    };
+}  // namespace ttlib